@@ -3,6 +3,7 @@
 
 #include "BaseGame.h"
 #include "Pins.h"
+#include "Assets.h"
 
 /**
  * @brief Configuration constants for the Archery Challenge game.
@@ -126,10 +127,31 @@ public:
      */
     bool run() override;
 
+    /**
+     * @brief Returns the current game state as a raw value.
+     */
+    uint8_t getStateCode() const override { return static_cast<uint8_t>(state); }
+
+    /**
+     * @brief Current round.
+     */
+    uint32_t getProgress() const override { return currentRound; }
+
+    /**
+     * @brief Makes init() continue at a checkpointed round.
+     */
+    void resumeFrom(uint32_t progress) override;
+
+    /**
+     * @brief Returns the game to its initial state, the next run() starts it over.
+     */
+    void reset() override;
+
 private:
     // Game state tracking
     ArcheryState state;
     int currentRound;
+    int resumeRound; // Round init() starts at
     bool roundResult; // Result of the last round (hit or fail)
 
     unsigned long stateStart; // Timestamp of state start (for timing)
@@ -183,10 +205,10 @@ private:
      * @brief Displays a message on the LCD screen.
      *
      * @param line1 First line of text to display
-     * @param line2 Second line of text to display (optional)
+     * @param line2 Second line of text to display (StringId::Count for none)
      * @param hideTimer Whether to hide the timer during this message
      */
-    void displayLcdMessage(const char* line1, const char* line2 = nullptr, bool hideTimer = false);
+    void displayLcdMessage(StringId line1, StringId line2 = StringId::Count, bool hideTimer = false);
     
     /**
      * @brief Displays round information on the LCD.
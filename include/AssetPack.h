@@ -0,0 +1,130 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "Assets.h"
+#include "FlashLayout.h"
+
+/**
+ * @brief Versioned asset pack at a fixed flash address.
+ *
+ * The pack is built on the host by tools/build_asset_pack.py and flashed to
+ * FlashLayout::ASSET_PACK_ADDR on its own, so glyphs, melodies, strings and
+ * tuning values can change without rebuilding the firmware. It is read in
+ * place through the memory-mapped flash; nothing is copied to RAM.
+ *
+ * Layout (little endian, sections 4-byte aligned):
+ *   Header | SectionEntry[sectionCount] | sections...
+ * The CRC covers everything after the crc field up to totalSize. A pack with
+ * a bad header, CRC, index or a string table built for different string IDs
+ * is rejected and the built-in assets are used instead.
+ */
+namespace AssetPack
+{
+    /** @brief "APAK" */
+    constexpr uint32_t MAGIC = 0x4B415041;
+
+    /** @brief Layout version, bumped on incompatible format changes */
+    constexpr uint16_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Section types.
+     */
+    enum class SectionType : uint16_t
+    {
+        Strings = 1,  ///< uint16_t offsets[count], then NUL-terminated texts
+        Glyphs = 2,   ///< uint8_t bitmaps[count][8]
+        Melodies = 3, ///< MelodyEntry[count], then Note[]
+        Tuning = 4,   ///< TuningEntry[count]
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t crc;           ///< CRC-32 of bytes [8, totalSize)
+        uint16_t formatVersion;
+        uint16_t sectionCount;
+        uint32_t packVersion;   ///< Content version chosen by the pack author
+        uint32_t totalSize;     ///< Header, index and sections in bytes
+        uint32_t schema;        ///< CRC-32 of the StringId names, one per line
+    };
+
+    struct SectionEntry
+    {
+        uint16_t type;
+        uint16_t count;  ///< Number of entries
+        uint32_t offset; ///< From the start of the pack
+        uint32_t size;   ///< In bytes
+    };
+
+    struct MelodyEntry
+    {
+        uint16_t firstNote; ///< Index into the note table after the entries
+        uint8_t length;
+        uint8_t reserved;
+        uint16_t pauseMs;
+        uint16_t reserved2;
+    };
+
+    struct TuningEntry
+    {
+        uint16_t key; ///< TuningKey value
+        uint16_t reserved;
+        int32_t value;
+    };
+
+    static_assert(sizeof(Header) == 24 && sizeof(SectionEntry) == 12, "Pack structures must match the host tool");
+    static_assert(sizeof(MelodyEntry) == 8 && sizeof(TuningEntry) == 8 && sizeof(Note) == 6, "Pack structures must match the host tool");
+
+    /**
+     * @brief Result of the last mount().
+     */
+    enum class Status : uint8_t
+    {
+        Missing,        ///< Erased flash, no pack written
+        Mounted,
+        BadHeader,
+        BadCrc,
+        SchemaMismatch, ///< Built for a different StringId table
+        BadIndex,
+    };
+
+    /**
+     * @brief Validates the pack and makes its sections available.
+     *
+     * @param base Start of the pack, the reserved flash region by default.
+     * @return Status::Mounted if the pack is used.
+     */
+    Status mount(const uint8_t *base = reinterpret_cast<const uint8_t *>(FlashLayout::ASSET_PACK_ADDR));
+
+    /**
+     * @brief Result of the last mount().
+     */
+    Status status();
+
+    /**
+     * @brief Content version of the mounted pack, 0 if none.
+     */
+    uint32_t version();
+
+    /**
+     * @brief Text of a string entry, nullptr if the pack does not have it.
+     */
+    const char *string(uint8_t index);
+
+    /**
+     * @brief Bitmap of a glyph entry, nullptr if the pack does not have it.
+     */
+    const uint8_t *glyph(uint8_t index);
+
+    /**
+     * @brief Fills in a melody entry, false if the pack does not have it.
+     */
+    bool melody(uint8_t index, Melody &melody);
+
+    /**
+     * @brief Looks up a tuning value by key, false if the pack does not have it.
+     */
+    bool tuning(uint16_t key, int32_t &value);
+}
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,120 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief UI strings, one per entry in AssetStrings.def.
+ */
+enum class StringId : uint8_t
+{
+#define ASSET_STRING(id, text) id,
+#include "AssetStrings.def"
+#undef ASSET_STRING
+    Count
+};
+
+/**
+ * @brief 5x8 LCD custom character bitmaps.
+ */
+enum class GlyphId : uint8_t
+{
+    LlamaStandingPart1,
+    LlamaStandingPart2,
+    LlamaRightFootPart1,
+    LlamaRightFootPart2,
+    LlamaLeftFootPart1,
+    LlamaLeftFootPart2,
+    CactusPart1,
+    CactusPart2,
+    BirdWingsUp,
+    BirdWingsDown,
+    Count
+};
+
+/**
+ * @brief Buzzer melodies.
+ */
+enum class MelodyId : uint8_t
+{
+    Win,
+    Lose,
+    RoundStart,
+    ImperialMarch,
+    Count
+};
+
+/**
+ * @brief Difficulty parameters that an asset pack can override.
+ */
+enum class TuningKey : uint16_t
+{
+#define TUNING_KEY(id, key) id = key,
+#include "TuningKeys.def"
+#undef TUNING_KEY
+};
+
+/**
+ * @brief One note of a melody.
+ */
+struct Note
+{
+    uint16_t frequency; ///< Tone frequency in Hz
+    uint16_t duration;  ///< Tone duration in ms
+    uint16_t gap;       ///< Time from the start of this note to the next one in ms
+};
+
+/**
+ * @brief A melody stored as a note table.
+ */
+struct Melody
+{
+    const Note *notes;  ///< First note
+    uint8_t length;     ///< Number of notes
+    uint16_t pauseMs;   ///< Silence after the last note (between repetitions)
+};
+
+/**
+ * @brief Read-only assets shared by all games.
+ *
+ * Every bitmap, melody and UI string is a const object, so it stays in flash
+ * and is read in place instead of being copied to RAM at startup. Callers
+ * refer to assets by their compact ID; tools/asset_report.py prints the
+ * flash/RAM budget of the tables at build time.
+ *
+ * If a valid asset pack (AssetPack.h) is present, its entries take precedence
+ * over the built-in tables.
+ */
+namespace Assets
+{
+    /**
+     * @brief Mounts the asset pack, call once at boot before using any asset.
+     */
+    void begin();
+
+    /**
+     * @brief Returns the text of a UI string.
+     */
+    const char *string(StringId id);
+
+    /**
+     * @brief Returns the 8-row bitmap of a custom character.
+     */
+    const uint8_t *glyph(GlyphId id);
+
+    /**
+     * @brief Returns a melody, the notes are read in place.
+     */
+    Melody melody(MelodyId id);
+
+    /**
+     * @brief Looks up a tuning override from the asset pack.
+     *
+     * @param key   Parameter to look up.
+     * @param value Set to the override if there is one.
+     * @return true if the pack overrides the parameter.
+     */
+    bool tuning(TuningKey key, int32_t &value);
+}
+
+#endif // ASSETS_H
@@ -2,6 +2,7 @@
 #define BASE_GAME_H
 
 #include <Arduino.h>
+#include "Clock.h"
 
 extern bool showTimer;
 
@@ -24,7 +25,62 @@ public:
      */
     virtual bool run() = 0;
 
+    /**
+     * @brief Current state of the game's state machine as a raw value.
+     *
+     * Used by diagnostics, which do not know the game-specific state enums.
+     */
+    virtual uint8_t getStateCode() const = 0;
+
+    /**
+     * @brief Returns the game to its initial state, the next run() starts it over.
+     *
+     * Used by the operator console, so it must not block: no melodies, no
+     * display re-initialisation.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Coarse progress inside the game (level, round...) for checkpoints.
+     *
+     * At most 24 bits. Games without a meaningful midpoint keep the default
+     * and restart from the beginning after a reset.
+     */
+    virtual uint32_t getProgress() const { return 0; }
+
+    /**
+     * @brief Makes the next start of the game continue from a checkpointed progress.
+     *
+     * Called once at boot, before the game first runs. Values the game does
+     * not recognise are ignored.
+     */
+    virtual void resumeFrom(uint32_t progress) { (void)progress; }
+
+    /**
+     * @brief Takes the game's request for a checkpoint, see requestCheckpoint().
+     *
+     * @return true once per request.
+     */
+    bool takeCheckpointRequest()
+    {
+        bool requested = checkpointRequested;
+        checkpointRequested = false;
+        return requested;
+    }
+
 protected:
+    /**
+     * @brief Asks for a checkpoint after the current run().
+     *
+     * Call where the progress has just changed or a pause begins, never in
+     * the middle of a timed action: saving programs flash, and filling a
+     * page erases one, which stalls the CPU for about 40 ms.
+     */
+    void requestCheckpoint()
+    {
+        checkpointRequested = true;
+    }
+
     /**
      * @brief Check if a specified time interval has elapsed since a given start time.
      *
@@ -33,7 +89,7 @@ protected:
      */
     bool hasElapsed(unsigned long start, unsigned long delayTime) const
     {
-        return (millis() - start) >= delayTime;
+        return (Clock::now() - start) >= delayTime;
     }
 
     /**
@@ -41,8 +97,11 @@ protected:
      */
     void resetTimer(unsigned long &timerRef)
     {
-        timerRef = millis();
+        timerRef = Clock::now();
     }
+
+private:
+    bool checkpointRequested = false;
 };
 
 #endif
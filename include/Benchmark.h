@@ -0,0 +1,23 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief On-target benchmark suite.
+ *
+ * Built only in the bench environment (BENCHMARK defined). Drives every game
+ * through a scripted input scenario and prints one JSON object per line on
+ * Serial, so results can be collected and compared build over build.
+ */
+namespace Benchmark
+{
+    /**
+     * @brief Runs all benchmark scenarios and prints the results.
+     *
+     * Call once from setup() after the hardware has been initialized.
+     */
+    void runAll();
+}
+
+#endif // BENCHMARK_H
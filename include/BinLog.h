@@ -0,0 +1,84 @@
+#ifndef BIN_LOG_H
+#define BIN_LOG_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Record formats, one per entry in LogFormats.def.
+ */
+enum class LogFormat : uint8_t
+{
+#define LOG_FORMAT(id, text) id,
+#include "LogFormats.def"
+#undef LOG_FORMAT
+    Count
+};
+
+/**
+ * @brief Heap-free, non-blocking binary logger.
+ *
+ * Instead of formatting text on the target, a record stores only the format ID,
+ * a millisecond timestamp and the integer arguments. Records are appended to a
+ * single-producer/single-consumer ring buffer and drained to Serial from loop()
+ * as whole records that fit the UART transmit buffer, so logging never waits
+ * for the wire and other output on the port never splits a record. tools/binlog_decode.py turns the stream back into text.
+ *
+ * Record layout:
+ *   0xA5 | format | payload length | varint timestamp | zigzag varint args... | checksum
+ * The checksum is the sum of all bytes after the sync byte. Plain ASCII
+ * output on the same port passes through the decoder unchanged.
+ */
+namespace BinLog
+{
+    /** @brief First byte of every record, never part of ASCII text */
+    constexpr uint8_t SYNC = 0xA5;
+
+    /** @brief Ring buffer size in bytes, must be a power of two */
+    constexpr uint16_t RING_SIZE = 512;
+
+    /** @brief Maximum number of arguments per record */
+    constexpr uint8_t MAX_ARGS = 5;
+
+    /**
+     * @brief Appends a record to the ring.
+     *
+     * Drops the record and counts it if the ring is full.
+     *
+     * @param format Format ID.
+     * @param args   Argument values.
+     * @param argc   Number of arguments (at most MAX_ARGS).
+     */
+    void write(LogFormat format, const int32_t *args, uint8_t argc);
+
+    /**
+     * @brief Logs a record with any number of integer arguments.
+     */
+    template <typename... Args>
+    inline void log(LogFormat format, Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+        const int32_t values[sizeof...(Args) + 1] = {static_cast<int32_t>(args)..., 0};
+        write(format, values, sizeof...(Args));
+    }
+
+    /**
+     * @brief Moves as many whole records as the UART can take without blocking.
+     *
+     * Call once per loop() iteration.
+     */
+    void drain();
+
+    /**
+     * @brief Blocks until every queued record has been handed to the UART.
+     *
+     * Used before binary dumps that must not land in the middle of a record.
+     */
+    void flush();
+
+    /**
+     * @brief Number of records dropped because the ring was full.
+     */
+    uint32_t droppedCount();
+}
+
+#endif // BIN_LOG_H
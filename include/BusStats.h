@@ -0,0 +1,63 @@
+#ifndef BUS_STATS_H
+#define BUS_STATS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Counters for the traffic each component puts on its bus.
+ *
+ * Compiled in only when ENABLE_BUS_STATS is defined (see the bench environment
+ * in platformio.ini). Without it every BUS_STATS_ADD() expands to nothing.
+ */
+namespace BusStats
+{
+    /** @brief Bytes on the I2C bus per LCD byte (2 nibbles x 3 PCF8574 writes x address + data) */
+    constexpr uint32_t LCD_I2C_BYTES_PER_TRANSFER = 12;
+
+    /** @brief Time the HD44780 needs to execute clear() and home() */
+    constexpr uint32_t LCD_SLOW_COMMAND_MS = 2;
+
+    /**
+     * @brief Snapshot of all bus counters.
+     */
+    struct Counters
+    {
+        uint32_t i2cBytes;          ///< Bytes clocked out on the LCD I2C bus
+        uint32_t tm1638Transactions; ///< Strobe-framed transfers to the TM1638
+        uint32_t toneCalls;         ///< Calls to tone()
+        uint32_t delayMs;           ///< Milliseconds spent in blocking waits
+    };
+
+#ifdef ENABLE_BUS_STATS
+    extern Counters counters;
+
+    /**
+     * @brief Clears all counters.
+     */
+    inline void reset()
+    {
+        counters = Counters{};
+    }
+#endif
+}
+
+#ifdef ENABLE_BUS_STATS
+#define BUS_STATS_ADD(field, amount) (BusStats::counters.field += (amount))
+#else
+#define BUS_STATS_ADD(field, amount) ((void)0)
+#endif
+
+/**
+ * @brief Blocking delay that is accounted for in the bus statistics.
+ *
+ * Use this instead of delay() so the benchmarks can see how long the loop stalls.
+ *
+ * @param ms Delay in milliseconds.
+ */
+inline void blockingDelay(unsigned long ms)
+{
+    BUS_STATS_ADD(delayMs, ms);
+    delay(ms);
+}
+
+#endif // BUS_STATS_H
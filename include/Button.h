@@ -2,27 +2,95 @@
 #define BUTTON_H
 
 #include <Arduino.h>
+#include "Clock.h"
+#include "FastPin.h"
+#include "Stimulus.h"
 
+/**
+ * @class Button
+ * @brief Debounced push button on a pull-up input.
+ *
+ * The pin is a template parameter so every read is a single register load
+ * through FastPin instead of a digitalRead() lookup.
+ *
+ * @tparam PIN Arduino pin number, pressed pulls it LOW.
+ */
+template <uint8_t PIN>
 class Button
 {
 public:
-    // Constructor: specify pin and optional debounce delay (milliseconds)
-    Button(uint8_t pin, unsigned long debounceDelay = 50);
+    // Constructor: optional debounce delay (milliseconds)
+    explicit Button(unsigned long debounceDelay = 50)
+        : _debounceDelay(debounceDelay), _lastReading(HIGH), // Default to HIGH with INPUT_PULLUP
+          _buttonState(HIGH), _lastDebounceTime(0), _prevPress(false), _wasPressedFlag(false), _pressTime(0)
+    {
+        pinMode(PIN, INPUT_PULLUP);
+    }
 
-    // You have this already implemented elsewhere.
-    // It's responsible for returning true if the button is pressed, false if not,
-    // while applying debouncing logic internally.
-    bool readWithDebounce();
+    // Returns true while the button is held down, without debouncing.
+    bool isDown() const
+    {
+        return Stimulus::level(PIN, FastPin<PIN>::read()) == LOW;
+    }
+
+    // Returns true if the button is pressed, applying the debounce delay.
+    bool readWithDebounce()
+    {
+        int reading = Stimulus::level(PIN, FastPin<PIN>::read());
+
+        // If the reading has changed, reset debounce timer
+        if (reading != _lastReading)
+        {
+            _lastDebounceTime = Clock::now();
+        }
+
+        // If it's been longer than the debounce delay, accept the new reading
+        if ((Clock::now() - _lastDebounceTime) > _debounceDelay)
+        {
+            _buttonState = reading;
+        }
+
+        _lastReading = reading;
+
+        // Return true if pressed. With pull-up, pressed = LOW
+        return (_buttonState == LOW);
+    }
 
     // 1) Updates internal press-tracking each loop
     //    Returns the *current* stable pressed/not pressed state.
-    bool read();
+    bool read()
+    {
+        bool currentPress = readWithDebounce();
+
+        // Rising edge check: previously not pressed, now pressed => set flag
+        if (!_prevPress && currentPress)
+        {
+            _wasPressedFlag = true;
+            _pressTime = _lastDebounceTime; // When the level first changed, not when debouncing accepted it
+        }
+
+        _prevPress = currentPress;
+        return currentPress;
+    }
 
     // 2) Returns true if the button was pressed since last check (rising edge).
-    bool wasPressed();
+    bool wasPressed()
+    {
+        if (_wasPressedFlag)
+        {
+            _wasPressedFlag = false;
+            return true;
+        }
+        return false;
+    }
+
+    // 3) Time (Clock::now()) the last press began, the timestamp of the wasPressed() event.
+    unsigned long pressTime() const
+    {
+        return _pressTime;
+    }
 
 private:
-    uint8_t _pin;
     unsigned long _debounceDelay;
 
     // Internal state used for debouncing logic
@@ -33,6 +101,7 @@ private:
     // Press event tracking
     bool _prevPress;
     bool _wasPressedFlag;
+    unsigned long _pressTime;
 };
 
 #endif // BUTTON_H
@@ -1,3 +1,5 @@
+#include "Assets.h"
+
 /**
  * @class Buzzer
  * @brief Encapsulates the behavior of a simple buzzer component.
@@ -32,32 +34,12 @@ public:
     void stop();
 
     /**
-     * @brief Plays a winning melody.
-     *
-     * @param repeat Number of times to repeat the melody.
-     */
-    void playWinMelody(unsigned int repeat = 1);
-
-    /**
-     * @brief Plays a losing melody.
-     *
-     * @param repeat Number of times to repeat the melody.
-     */
-    void playLoseMelody(unsigned int repeat = 1);
-
-    /**
-     * @brief Plays a round start melody.
-     *
-     * @param repeat Number of times to repeat the melody.
-     */
-    void playRoundStartMelody(unsigned int repeat = 1);
-
-    /**
-     * @brief Plays the Imperial March melody.
+     * @brief Plays a melody from the asset table.
      *
+     * @param id     Melody to play.
      * @param repeat Number of times to repeat the melody.
      */
-    void playImperialMarch(unsigned int repeat = 1);
+    void playMelody(MelodyId id, unsigned int repeat = 1);
 
 private:
     int _pin;
@@ -0,0 +1,57 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Session checkpoints that survive a reset or brown-out.
+ *
+ * The running session (challenge, coarse in-game progress and elapsed time)
+ * is saved to its own FlashKvStore, so a reset in the middle of a session
+ * resumes the same challenge with the same time left instead of going back to
+ * "Press start btn". Backup registers are not used: VBAT is tied to VDD on the
+ * Nucleo board, so they are lost together with the supply.
+ *
+ * Challenge and progress share one record and are always written together.
+ * Saves happen only at calm points (session start, challenge changes and the
+ * moments a challenge asks for, see BaseGame::requestCheckpoint()), because a
+ * save that fills a flash page erases one and stalls the CPU for about 40 ms.
+ * A resume therefore costs the player the time since the last calm point.
+ */
+namespace Checkpoint
+{
+    /** @brief Minimum time between two saves that only move the elapsed time */
+    constexpr unsigned long SAVE_INTERVAL_MS = 5000;
+
+    /** @brief State of a running session */
+    struct Session
+    {
+        uint8_t challenge;  ///< 1-based challenge index
+        uint32_t progress;  ///< BaseGame::getProgress(), at most 24 bits
+        uint32_t elapsedMs; ///< Time since the session started
+    };
+
+    /**
+     * @brief Mounts the checkpoint store and reads the saved session.
+     *
+     * Call once at boot.
+     *
+     * @param session Set to the saved session if there is one.
+     * @return true if a session was running when the board went down.
+     */
+    bool restore(Session &session);
+
+    /**
+     * @brief Saves the session if its challenge or progress changed or the save interval elapsed.
+     *
+     * May erase a flash page, call it only at calm points.
+     */
+    void save(const Session &session);
+
+    /**
+     * @brief Marks the session as finished so the next boot starts fresh.
+     */
+    void clear();
+}
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,59 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Game time source that a harness can take over.
+ *
+ * Game logic reads the time through Clock::now(). When ENABLE_VIRTUAL_CLOCK
+ * is defined and the virtual clock is active, now() returns a time that only
+ * moves when the harness advances it, so a scripted run is repeatable and
+ * does not have to wait for real time to pass. Otherwise it is millis().
+ *
+ * Bus timings (micros(), the cycle counter) always stay on real time.
+ */
+namespace Clock
+{
+#ifdef ENABLE_VIRTUAL_CLOCK
+    extern bool active;
+    extern unsigned long virtualMs;
+
+    /**
+     * @brief Switches game time to the virtual clock, starting at the current millis().
+     */
+    inline void useVirtual()
+    {
+        virtualMs = ::millis();
+        active = true;
+    }
+
+    /**
+     * @brief Hands game time back to millis().
+     */
+    inline void useReal()
+    {
+        active = false;
+    }
+
+    /**
+     * @brief Moves the virtual clock forward.
+     */
+    inline void advance(unsigned long ms)
+    {
+        virtualMs += ms;
+    }
+
+    inline unsigned long now()
+    {
+        return active ? virtualMs : ::millis();
+    }
+#else
+    inline unsigned long now()
+    {
+        return ::millis();
+    }
+#endif
+}
+
+#endif // CLOCK_H
@@ -0,0 +1,81 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Line-based operator console on a serial port.
+ *
+ * poll() moves at most MAX_BYTES_PER_POLL bytes from the UART receive ring
+ * into a fixed line buffer and runs at most one command per call, so the
+ * loop never waits for the operator. A finished line is split in place into
+ * whitespace-separated arguments (no heap, no copies) and dispatched through
+ * the command table given to begin().
+ */
+namespace Console
+{
+    /** @brief Longest accepted command line, longer lines are discarded */
+    constexpr uint8_t LINE_BYTES = 48;
+
+    /** @brief Maximum number of arguments, including the command name */
+    constexpr uint8_t MAX_ARGS = 4;
+
+    /** @brief Bytes taken from the receive ring per poll() */
+    constexpr uint8_t MAX_BYTES_PER_POLL = 16;
+
+    /**
+     * @brief Arguments of one command line, pointing into the line buffer.
+     */
+    struct Args
+    {
+        uint8_t count;                ///< Number of arguments, including the command name
+        const char *values[MAX_ARGS]; ///< Null-terminated arguments
+
+        /**
+         * @brief Parses an argument as a signed decimal integer.
+         *
+         * @param index Argument index, 1 is the first after the command name.
+         * @param value Set to the parsed value.
+         * @return false if the argument is missing or not a number.
+         */
+        bool toInt(uint8_t index, long &value) const;
+    };
+
+    /** @brief Runs a command, prints its reply to out */
+    typedef void (*Handler)(const Args &args, Print &out);
+
+    /**
+     * @brief One entry of the command table.
+     */
+    struct Command
+    {
+        const char *name;        ///< First word of the line
+        const char *usage;       ///< Arguments, shown by printHelp()
+        const char *description; ///< One line, shown by printHelp()
+        Handler handler;
+    };
+
+    /**
+     * @brief Sets the command table.
+     *
+     * @param commands Table, must outlive the console.
+     * @param count    Number of entries.
+     */
+    void begin(const Command *commands, uint8_t count);
+
+    /**
+     * @brief Reads pending input and runs at most one complete command.
+     *
+     * Call once per loop().
+     *
+     * @param port Serial port to read from and reply to.
+     */
+    void poll(Stream &port);
+
+    /**
+     * @brief Lists the commands with their usage.
+     */
+    void printHelp(Print &out);
+}
+
+#endif // CONSOLE_H
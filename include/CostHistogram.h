@@ -0,0 +1,62 @@
+#ifndef COST_HISTOGRAM_H
+#define COST_HISTOGRAM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Histogram of tick costs with four buckets per power of two,
+ * so percentiles come out within 25%.
+ *
+ * Values 0-3 get a bucket each. Above that, bucket 4 * (e - 1) + q holds the
+ * values whose highest set bit is e and whose next two bits are q. Zero
+ * initialised, as a static or with {}.
+ */
+struct CostHistogram
+{
+    static constexpr uint8_t BUCKETS = 124; // Up to the top quarter of 2^31
+
+    uint32_t counts[BUCKETS];
+    uint32_t total;
+    uint32_t maxUs;
+
+    static uint8_t bucketFor(uint32_t us)
+    {
+        if (us < 4)
+            return us;
+        uint8_t exponent = 31 - __builtin_clz(us);
+        return 4 * (exponent - 1) + ((us >> (exponent - 2)) & 3);
+    }
+
+    static uint32_t lowerBound(uint8_t bucket)
+    {
+        if (bucket < 4)
+            return bucket;
+        return (uint32_t)(4 + bucket % 4) << (bucket / 4 - 1);
+    }
+
+    void add(uint32_t us)
+    {
+        counts[bucketFor(us)]++;
+        total++;
+        if (us > maxUs)
+            maxUs = us;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the given percentile.
+     */
+    uint32_t percentile(uint16_t permille) const
+    {
+        uint32_t rank = ((uint64_t)total * permille + 999) / 1000;
+        uint32_t seen = 0;
+        for (uint8_t bucket = 0; bucket < BUCKETS; bucket++)
+        {
+            seen += counts[bucket];
+            if (seen >= rank && seen > 0)
+                return bucket + 1 < BUCKETS ? lowerBound(bucket + 1) - 1 : maxUs;
+        }
+        return maxUs;
+    }
+};
+
+#endif // COST_HISTOGRAM_H
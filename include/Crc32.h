@@ -0,0 +1,59 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief CRC-32 (IEEE 802.3, same as zlib.crc32 in Python).
+ *
+ * Bitwise and table-free to keep flash use small; usable in constant
+ * expressions.
+ */
+namespace Crc32
+{
+    /**
+     * @brief Feeds one byte into a running (inverted) CRC.
+     */
+    constexpr uint32_t update(uint32_t crc, uint8_t byte)
+    {
+        crc ^= byte;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Computes or continues a CRC-32.
+     *
+     * @param data   Bytes to checksum.
+     * @param length Number of bytes.
+     * @param crc    Result of the previous block when checksumming in pieces.
+     */
+    constexpr uint32_t compute(const uint8_t *data, size_t length, uint32_t crc = 0)
+    {
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++)
+        {
+            crc = update(crc, data[i]);
+        }
+        return ~crc;
+    }
+
+    /**
+     * @brief CRC-32 of a string, without the terminator.
+     */
+    constexpr uint32_t compute(const char *text, size_t length)
+    {
+        uint32_t crc = 0xFFFFFFFFUL;
+        for (size_t i = 0; i < length; i++)
+        {
+            crc = update(crc, static_cast<uint8_t>(text[i]));
+        }
+        return ~crc;
+    }
+}
+
+#endif // CRC32_H
@@ -0,0 +1,41 @@
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Thin wrapper around the Cortex-M4 DWT cycle counter.
+ *
+ * The counter runs at the core clock (72 MHz on the F303) and wraps after
+ * roughly 59 seconds, so only use it for measuring short intervals.
+ */
+namespace CycleCounter
+{
+    /**
+     * @brief Enables the trace unit and starts the cycle counter.
+     */
+    inline void begin()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /**
+     * @brief Returns the current cycle count.
+     */
+    inline uint32_t now()
+    {
+        return DWT->CYCCNT;
+    }
+
+    /**
+     * @brief Converts a number of cycles to microseconds.
+     */
+    inline uint32_t toMicros(uint32_t cycles)
+    {
+        return cycles / (SystemCoreClock / 1000000UL);
+    }
+}
+
+#endif // CYCLE_COUNTER_H
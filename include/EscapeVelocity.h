@@ -121,11 +121,33 @@ public:
      */
     bool run() override;
 
+    /**
+     * @brief Returns the current game state as a raw value.
+     */
+    uint8_t getStateCode() const override { return static_cast<uint8_t>(state); }
+
+    /**
+     * @brief Current gate in the low byte, remaining lives in the next.
+     */
+    uint32_t getProgress() const override { return currentGate | (lives << 8); }
+
+    /**
+     * @brief Makes init() continue at a checkpointed gate with the same lives.
+     */
+    void resumeFrom(uint32_t progress) override;
+
+    /**
+     * @brief Returns the game to its initial state, the next run() starts it over.
+     */
+    void reset() override;
+
 private:
     // Overall game state
     EscVelocityState state;      ///< Current game state
     int currentGate;             ///< Current gate number (1-based)
     int lives;                   ///< Remaining lives
+    int resumeGate;              ///< Gate init() starts at
+    int resumeLives;             ///< Lives init() starts with
     unsigned long stateStart;    ///< Timestamp when current state started
     bool gateResult;             ///< Result of the last gate attempt
     bool showTimerFlag;          ///< Whether to show the timer
@@ -0,0 +1,100 @@
+#ifndef FAST_PIN_H
+#define FAST_PIN_H
+
+#include <Arduino.h>
+
+/**
+ * @brief GPIO behind the Arduino header pins of the Nucleo-F303RE.
+ *
+ * Only the pins wired in pins.h are listed; a FastPin on any other pin fails
+ * to compile.
+ */
+namespace FastPinMap
+{
+    struct Gpio
+    {
+        uintptr_t port; ///< GPIOx_BASE, 0 if the pin is not mapped
+        uint8_t bit;
+    };
+
+    constexpr Gpio of(uint8_t pin)
+    {
+        return pin == 2    ? Gpio{GPIOA_BASE, 10}
+               : pin == 3  ? Gpio{GPIOB_BASE, 3}
+               : pin == 4  ? Gpio{GPIOB_BASE, 5}
+               : pin == 5  ? Gpio{GPIOB_BASE, 4}
+               : pin == 6  ? Gpio{GPIOB_BASE, 10}
+               : pin == 8  ? Gpio{GPIOA_BASE, 9}
+               : pin == 9  ? Gpio{GPIOC_BASE, 7}
+               : pin == 10 ? Gpio{GPIOB_BASE, 6}
+               : pin == A0 ? Gpio{GPIOA_BASE, 0}
+                           : Gpio{0, 0};
+    }
+}
+
+/**
+ * @brief Direct register access to one GPIO pin.
+ *
+ * Port and mask are resolved at compile time, so read() is a single IDR load
+ * and high()/low() a single BSRR store, instead of the pin-map lookup that
+ * digitalRead()/digitalWrite() do on every call. Configure the pin once with
+ * pinMode(); input()/output() only flip MODER for pins that change direction
+ * during a transfer, like the TM1638 data line.
+ *
+ * @tparam PIN Arduino pin number, see FastPinMap::of().
+ */
+template <uint8_t PIN>
+struct FastPin
+{
+    static constexpr uintptr_t PORT = FastPinMap::of(PIN).port;
+    static constexpr uint8_t BIT = FastPinMap::of(PIN).bit;
+    static constexpr uint32_t MASK = 1UL << BIT;
+
+    static_assert(PORT != 0, "pin missing from FastPinMap");
+
+    static inline GPIO_TypeDef *gpio()
+    {
+        return reinterpret_cast<GPIO_TypeDef *>(PORT);
+    }
+
+    /**
+     * @brief Current input level, HIGH or LOW.
+     */
+    static inline int read()
+    {
+        return (gpio()->IDR & MASK) ? HIGH : LOW;
+    }
+
+    static inline void high()
+    {
+        gpio()->BSRR = MASK;
+    }
+
+    static inline void low()
+    {
+        gpio()->BSRR = MASK << 16;
+    }
+
+    static inline void write(bool level)
+    {
+        gpio()->BSRR = level ? MASK : MASK << 16;
+    }
+
+    /**
+     * @brief Switches the pin to input, keeping its pull configuration.
+     */
+    static inline void input()
+    {
+        gpio()->MODER &= ~(3UL << (2 * BIT));
+    }
+
+    /**
+     * @brief Switches the pin to push-pull output.
+     */
+    static inline void output()
+    {
+        gpio()->MODER = (gpio()->MODER & ~(3UL << (2 * BIT))) | (1UL << (2 * BIT));
+    }
+};
+
+#endif // FAST_PIN_H
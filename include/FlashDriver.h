@@ -0,0 +1,59 @@
+#ifndef FLASH_DRIVER_H
+#define FLASH_DRIVER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Minimal internal flash access on top of the STM32 HAL.
+ *
+ * Execution from flash stalls while a page is erased or programmed (about
+ * 40 ms per page erase), so only use it outside of time-critical game ticks.
+ */
+namespace FlashDriver
+{
+    /**
+     * @brief Erases one page, every byte reads 0xFF afterwards.
+     *
+     * @param address Start of the page.
+     * @return true on success.
+     */
+    bool erasePage(uintptr_t address);
+
+    /**
+     * @brief Programs consecutive half-words, the target must be erased.
+     *
+     * @param address   Half-word aligned destination.
+     * @param halfWords Values to write.
+     * @param count     Number of half-words.
+     * @return true on success.
+     */
+    bool program(uintptr_t address, const uint16_t *halfWords, uint8_t count);
+
+#ifndef ARDUINO
+    /**
+     * @brief Host builds: flash simulated in place, with power cuts.
+     *
+     * The addresses handed to the driver point at a RAM buffer the test owns,
+     * erased pages are FlashLayout::PAGE_BYTES long. Like the F303, a half-word
+     * can only be programmed while it reads 0xFFFF.
+     *
+     * Every page erase and every half-word program is one operation. After
+     * cutPowerAfter(n) the first n operations go through and every later one
+     * fails without effect, until restorePower(). The operation the power dies
+     * in is torn: a cut erase leaves only the first half of the page erased.
+     */
+    namespace Sim
+    {
+        void cutPowerAfter(uint32_t operations);
+        void restorePower();
+
+        /** @brief True once an operation was refused since restorePower() */
+        bool powerLost();
+
+        /** @brief Operations carried out since restorePower() */
+        uint32_t operations();
+    }
+#endif
+}
+
+#endif // FLASH_DRIVER_H
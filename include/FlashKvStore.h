@@ -0,0 +1,106 @@
+#ifndef FLASH_KV_STORE_H
+#define FLASH_KV_STORE_H
+
+#include <stdint.h>
+
+/**
+ * @class FlashKvStore
+ * @brief Wear-leveled key/value store in a few pages of internal flash.
+ *
+ * Emulated EEPROM: every write appends an 8-byte record to the active page,
+ * the latest record of a key wins. When the page is full, the latest value of
+ * every key is copied to the next page in rotation, so erases are spread over
+ * all pages.
+ *
+ * Records are programmed value first, then key, then check, and only count
+ * with a matching check; a page only counts once its header magic is written
+ * after the copy. A power cut at any point therefore leaves either the old or
+ * the new value, never a torn one.
+ *
+ * Page:   magic (4) | sequence (2) | ~sequence (2) | records...
+ * Record: key (2) | check (2) | value (4)
+ */
+class FlashKvStore
+{
+public:
+    /** @brief Reserved, reads back from erased flash */
+    static constexpr uint16_t INVALID_KEY = 0xFFFF;
+
+    /**
+     * @brief Constructs a store over consecutive flash pages.
+     *
+     * @param baseAddr  Start of the first page.
+     * @param pageCount Number of pages to rotate through (at least 2).
+     * @param pageBytes Size of one page.
+     */
+    FlashKvStore(uintptr_t baseAddr, uint8_t pageCount, uint16_t pageBytes);
+
+    /**
+     * @brief Finds the active page, formats the store if there is none.
+     *
+     * @return false if the flash could not be formatted.
+     */
+    bool begin();
+
+    /**
+     * @brief Reads the latest value of a key.
+     *
+     * Scans the active page, meant for loading at boot rather than hot paths.
+     *
+     * @param key   Key to look up.
+     * @param value Set to the stored value if found.
+     * @return true if the key has a value.
+     */
+    bool read(uint16_t key, int32_t &value) const;
+
+    /**
+     * @brief Stores a value, skipping the write if it is unchanged.
+     *
+     * @param key   Key, anything but INVALID_KEY.
+     * @param value Value to store.
+     * @return true on success.
+     */
+    bool write(uint16_t key, int32_t value);
+
+    /**
+     * @brief Number of page rotations since the store was formatted.
+     */
+    uint16_t generation() const;
+
+    /**
+     * @brief Free record slots left in the active page.
+     */
+    uint16_t freeRecords() const;
+
+private:
+    static constexpr uint32_t MAGIC = 0x3153564B; // "KVS1"
+    static constexpr uint16_t HEADER_BYTES = 8;
+    static constexpr uint16_t RECORD_BYTES = 8;
+
+    struct Record
+    {
+        uint16_t key;
+        uint16_t check;
+        int32_t value;
+    };
+
+    uintptr_t pageAddr(uint8_t page) const;
+    const Record *recordAt(uint16_t offset) const;
+    bool isErased(uint16_t offset) const;
+    bool isValid(const Record &record) const;
+    bool isLatest(uint16_t offset) const;
+    bool rotate(uint16_t key, int32_t value);
+
+    static bool programRecord(uintptr_t address, uint16_t key, int32_t value);
+    static bool programHeader(uintptr_t address, uint16_t sequence);
+    static uint16_t checkOf(uint16_t key, int32_t value);
+
+    uintptr_t base;
+    uint8_t pages;
+    uint16_t pageBytes;
+    uint8_t activePage;
+    uint16_t sequence;
+    uint16_t writeOffset;
+};
+
+#endif // FLASH_KV_STORE_H
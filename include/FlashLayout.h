@@ -0,0 +1,47 @@
+#ifndef FLASH_LAYOUT_H
+#define FLASH_LAYOUT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Flash map of the STM32F303RE (512 KB, 2 KB pages).
+ *
+ * The application image is limited to the bottom of flash by
+ * board_upload.maximum_size in platformio.ini, the pages above it hold data
+ * that can be rewritten without reflashing the code.
+ */
+namespace FlashLayout
+{
+    /** @brief Start of the memory-mapped flash */
+    constexpr uint32_t BASE_ADDR = 0x08000000;
+
+    /** @brief Total flash size */
+    constexpr uint32_t TOTAL_SIZE = 512UL * 1024;
+
+    /** @brief Erase granularity */
+    constexpr uint32_t PAGE_BYTES = 2048;
+
+    /** @brief Space for the application image, must match board_upload.maximum_size */
+    constexpr uint32_t APP_SIZE = 480UL * 1024;
+
+    /** @brief Asset pack written by tools/build_asset_pack.py */
+    constexpr uint32_t ASSET_PACK_ADDR = BASE_ADDR + APP_SIZE;
+    constexpr uint32_t ASSET_PACK_SIZE = 16UL * 1024;
+
+    /** @brief Tuning overrides (FlashKvStore), pages are used in rotation */
+    constexpr uint32_t CONFIG_ADDR = ASSET_PACK_ADDR + ASSET_PACK_SIZE;
+    constexpr uint8_t CONFIG_PAGES = 2;
+
+    /** @brief Session checkpoints (FlashKvStore), kept apart so frequent saves do not wear the config pages */
+    constexpr uint32_t CHECKPOINT_ADDR = CONFIG_ADDR + CONFIG_PAGES * PAGE_BYTES;
+    constexpr uint8_t CHECKPOINT_PAGES = 2;
+
+    /** @brief Per-session telemetry (FlashRecordLog), the oldest page is erased when full */
+    constexpr uint32_t TELEMETRY_ADDR = CHECKPOINT_ADDR + CHECKPOINT_PAGES * PAGE_BYTES;
+    constexpr uint8_t TELEMETRY_PAGES = 4;
+
+    static_assert(ASSET_PACK_ADDR % PAGE_BYTES == 0, "Asset pack must start on a page boundary");
+    static_assert(TELEMETRY_ADDR + TELEMETRY_PAGES * PAGE_BYTES <= BASE_ADDR + TOTAL_SIZE, "Flash map exceeds the device");
+}
+
+#endif // FLASH_LAYOUT_H
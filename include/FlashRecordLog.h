@@ -0,0 +1,86 @@
+#ifndef FLASH_RECORD_LOG_H
+#define FLASH_RECORD_LOG_H
+
+#include <stdint.h>
+
+/**
+ * @class FlashRecordLog
+ * @brief Append-only log of fixed-size records in a few pages of internal flash.
+ *
+ * Records fill the pages in order; when the last slot of a page is used the
+ * next page in rotation is erased, dropping the oldest records. The log
+ * therefore always keeps at least (pageCount - 1) pages of history and every
+ * page is erased equally often.
+ *
+ * Each slot carries a sequence number and a 16-bit check that is programmed
+ * last, so a record torn by a power cut never validates and is skipped.
+ *
+ * Slot: payload (recordBytes) | sequence (2) | check (2)
+ */
+class FlashRecordLog
+{
+public:
+    /**
+     * @brief Constructs a log over consecutive flash pages.
+     *
+     * @param baseAddr    Start of the first page.
+     * @param pageCount   Number of pages to rotate through (at least 2).
+     * @param pageBytes   Size of one page.
+     * @param recordBytes Payload size, a multiple of 4.
+     */
+    FlashRecordLog(uintptr_t baseAddr, uint8_t pageCount, uint16_t pageBytes, uint16_t recordBytes);
+
+    /**
+     * @brief Finds the newest record and the next free slot.
+     *
+     * Scans every slot, meant for boot.
+     */
+    void begin();
+
+    /**
+     * @brief Appends a record, erasing the oldest page when needed.
+     *
+     * @param payload recordBytes bytes.
+     * @return false if the flash could not be erased or programmed.
+     */
+    bool append(const void *payload);
+
+    /**
+     * @brief Copies the next record, oldest first.
+     *
+     * Start with cursor = 0 and call until it returns false.
+     *
+     * @param cursor  Iteration state, advanced past the returned record.
+     * @param payload Receives recordBytes bytes.
+     * @return false when there are no more records.
+     */
+    bool next(uint16_t &cursor, void *payload) const;
+
+    /**
+     * @brief Erases every page.
+     */
+    bool clear();
+
+    /**
+     * @brief Number of record slots, the most records the log can ever hold.
+     */
+    uint16_t capacity() const;
+
+private:
+    uintptr_t slotAddr(uint16_t slot) const;
+    bool isErased(uint16_t slot) const;
+    bool isValid(uint16_t slot) const;
+    uint16_t sequenceAt(uint16_t slot) const;
+    uint16_t checkOf(const uint8_t *payload, uint16_t sequence) const;
+
+    uintptr_t base;
+    uint8_t pages;
+    uint16_t pageBytes;
+    uint16_t recordBytes;
+    uint16_t slotBytes;
+    uint16_t slotsPerPage;
+    uint16_t writeSlot;    ///< Next slot to program, over all pages
+    uint16_t nextSequence; ///< Sequence number of the next record
+};
+
+#endif // FLASH_RECORD_LOG_H
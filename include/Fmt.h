@@ -0,0 +1,177 @@
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Allocation-free fixed-width integer formatting.
+ *
+ * Replacement for snprintf() and Print::print(int) on the display paths. Every
+ * field has its width as a template parameter, so the digit loops unroll and
+ * no format string is parsed at run time. The write*() functions fill a
+ * caller-provided buffer without a terminator; the *Field() functions return
+ * a terminated Field by value and can be evaluated at compile time:
+ *
+ *     static constexpr auto DEFAULT_TIME = Fmt::minutesSeconds(600); // "10:00"
+ *     lcd.print(Fmt::unsignedField<3>(score).text);                  // "  7"
+ *
+ * A value that does not fit its width saturates (999, -99, 99:59) instead of
+ * being cut, so a display never shows a misleading number.
+ */
+namespace Fmt
+{
+    /**
+     * @brief A formatted field with its terminator.
+     */
+    template <uint8_t WIDTH>
+    struct Field
+    {
+        char text[WIDTH + 1];
+    };
+
+    /**
+     * @brief Largest value that fits in the given number of digits.
+     */
+    constexpr uint32_t maxValue(uint8_t digits)
+    {
+        return digits >= 10 ? UINT32_MAX : (digits == 0 ? 0 : maxValue(digits - 1) * 10 + 9);
+    }
+
+    /**
+     * @brief Number of decimal digits of a value (at least 1).
+     */
+    constexpr uint8_t digitCount(uint32_t value)
+    {
+        return value < 10 ? 1 : 1 + digitCount(value / 10);
+    }
+
+    /**
+     * @brief Writes an unsigned value right-aligned in exactly WIDTH characters.
+     *
+     * @param out   Buffer of at least WIDTH characters, not terminated.
+     * @param value Value to write, saturates to WIDTH nines.
+     * @param pad   Fill character left of the digits, ' ' or '0'.
+     */
+    template <uint8_t WIDTH>
+    constexpr void writeUnsigned(char *out, uint32_t value, char pad = ' ')
+    {
+        static_assert(WIDTH >= 1 && WIDTH <= 10, "a uint32_t has 1 to 10 digits");
+
+        if (value > maxValue(WIDTH))
+            value = maxValue(WIDTH);
+
+        uint8_t i = WIDTH;
+        do
+        {
+            out[--i] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value != 0 && i > 0);
+
+        while (i > 0)
+            out[--i] = pad;
+    }
+
+    /**
+     * @brief Writes a signed value right-aligned in exactly WIDTH characters.
+     *
+     * With ' ' padding the minus sign sits right before the digits (" -42"),
+     * with '0' padding it takes the first column ("-042").
+     *
+     * @param out   Buffer of at least WIDTH characters, not terminated.
+     * @param value Value to write, negative values saturate to WIDTH - 1 digits.
+     * @param pad   Fill character, ' ' or '0'.
+     */
+    template <uint8_t WIDTH>
+    constexpr void writeSigned(char *out, int32_t value, char pad = ' ')
+    {
+        static_assert(WIDTH >= 2 && WIDTH <= 10, "room for the sign and the digits");
+
+        if (value >= 0)
+        {
+            writeUnsigned<WIDTH>(out, (uint32_t)value, pad);
+            return;
+        }
+
+        uint32_t magnitude = 0u - (uint32_t)value;
+        writeUnsigned<WIDTH - 1>(out + 1, magnitude, pad);
+        if (pad == '0')
+        {
+            out[0] = '-';
+            return;
+        }
+
+        out[0] = ' ';
+        uint8_t sign = 0;
+        while (sign + 1 < WIDTH && out[sign + 1] == ' ')
+            sign++;
+        out[sign] = '-';
+    }
+
+    /**
+     * @brief Writes a duration as MM:SS, exactly 5 characters.
+     *
+     * @param out     Buffer of at least 5 characters, not terminated.
+     * @param seconds Duration in seconds, saturates to 99:59.
+     */
+    constexpr void writeMinutesSeconds(char *out, uint32_t seconds)
+    {
+        uint32_t minutes = seconds / 60;
+        if (minutes > 99)
+        {
+            minutes = 99;
+            seconds = 59;
+        }
+        writeUnsigned<2>(out, minutes, '0');
+        out[2] = ':';
+        writeUnsigned<2>(out + 3, seconds % 60, '0');
+    }
+
+    /**
+     * @brief Right-aligned unsigned field, see writeUnsigned().
+     */
+    template <uint8_t WIDTH>
+    constexpr Field<WIDTH> unsignedField(uint32_t value, char pad = ' ')
+    {
+        Field<WIDTH> field{};
+        writeUnsigned<WIDTH>(field.text, value, pad);
+        field.text[WIDTH] = '\0';
+        return field;
+    }
+
+    /**
+     * @brief Zero-padded unsigned field ("007").
+     */
+    template <uint8_t WIDTH>
+    constexpr Field<WIDTH> zeroPadded(uint32_t value)
+    {
+        return unsignedField<WIDTH>(value, '0');
+    }
+
+    /**
+     * @brief Right-aligned signed field, see writeSigned().
+     */
+    template <uint8_t WIDTH>
+    constexpr Field<WIDTH> signedField(int32_t value, char pad = ' ')
+    {
+        Field<WIDTH> field{};
+        writeSigned<WIDTH>(field.text, value, pad);
+        field.text[WIDTH] = '\0';
+        return field;
+    }
+
+    /**
+     * @brief MM:SS field, see writeMinutesSeconds().
+     */
+    constexpr Field<5> minutesSeconds(uint32_t seconds)
+    {
+        Field<5> field{};
+        writeMinutesSeconds(field.text, seconds);
+        field.text[5] = '\0';
+        return field;
+    }
+
+    static_assert(minutesSeconds(600).text[0] == '1' && minutesSeconds(600).text[4] == '0', "10:00");
+    static_assert(signedField<4>(-42).text[1] == '-', "sign next to the digits");
+}
+
+#endif // FMT_H
@@ -1,20 +1,27 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
-#include <LiquidCrystal_I2C.h>
+#include "Lcd.h"
 #include "Buzzer.h"
 #include "RGBLed.h"
 #include "Whadda.h"
 #include "Button.h"
+#include "Pins.h"
+
+// -----------------------------------------------------------------------------
+// Game Configuration
+// -----------------------------------------------------------------------------
+/** @brief Default time to escape, tuning key GameDurationMs overrides it */
+constexpr unsigned long GAME_DURATION = 600000UL; // 10 minutes
 
 // -----------------------------------------------------------------------------
 // Component Instances - External Declarations
 // -----------------------------------------------------------------------------
-extern LiquidCrystal_I2C lcd;
+extern Lcd lcd;
 extern RGBLed rgbLed;
 extern Buzzer buzzer;
 extern Whadda whadda;
-extern Button button;
+extern Button<BTN_PIN> button;
 
 // -----------------------------------------------------------------------------
 // Global Variables
@@ -0,0 +1,57 @@
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Heap allocation tracking with a lock for the game loop.
+ *
+ * malloc, free, calloc and realloc are wrapped at link time
+ * (-Wl,--wrap=malloc,...), which also covers operator new/delete and the
+ * Arduino core. Every call is counted together with the bytes in use and
+ * the peak. After setup() the heap is locked: the game loop must run from
+ * static and stack memory only, so an allocation after the lock is counted
+ * and logged with its caller on the target, and asserts on a host build.
+ *
+ * Compiled in only when ENABLE_HEAP_GUARD is defined (see the heapguard
+ * environment in platformio.ini), otherwise all functions are empty inlines.
+ */
+namespace HeapGuard
+{
+    /**
+     * @brief Snapshot of the allocation counters.
+     */
+    struct Stats
+    {
+        uint32_t allocations;       ///< malloc/calloc/realloc calls that returned memory
+        uint32_t frees;             ///< free calls with a non-null pointer
+        uint32_t bytesRequested;    ///< Sum of all requested sizes
+        uint32_t bytesInUse;        ///< Usable size of the live blocks
+        uint32_t peakBytesInUse;    ///< Highest bytesInUse so far
+        uint32_t lockedAllocations; ///< Allocations after lock()
+        uintptr_t lastLockedCaller; ///< Return address of the last one, for addr2line
+    };
+
+#ifdef ENABLE_HEAP_GUARD
+    /**
+     * @brief Forbids further allocations, call at the end of setup().
+     */
+    void lock();
+
+    /**
+     * @brief Current counters.
+     */
+    Stats stats();
+
+    /**
+     * @brief Prints the counters.
+     */
+    void print(Print &out);
+#else
+    inline void lock() {}
+    inline Stats stats() { return Stats{}; }
+    inline void print(Print &) {}
+#endif
+}
+
+#endif // HEAP_GUARD_H
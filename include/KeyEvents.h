@@ -0,0 +1,123 @@
+#ifndef KEY_EVENTS_H
+#define KEY_EVENTS_H
+
+#include <stdint.h>
+
+/**
+ * @brief One key going down.
+ */
+struct KeyEvent
+{
+    uint8_t key;     ///< Key index 0-7
+    uint32_t timeUs; ///< micros() of the scan that saw the key go down
+};
+
+/**
+ * @brief Turns TM1638 key scans into a time-ordered queue of key-down events.
+ *
+ * Debouncing does not wait: a key counts as down on the first scan that sees
+ * it, and its level is then held for the lockout time, so contact bounce can
+ * neither repeat nor end the press. Scans arrive in time order and every scan
+ * appends its new presses, so the queue is ordered by timestamp. Keys that go
+ * down in the same scan share a timestamp and are queued by key index.
+ *
+ * When the queue is full, new presses are counted in dropped() and lost.
+ *
+ * @tparam CAPACITY Queued events, a power of two.
+ */
+template <uint8_t CAPACITY>
+class KeyEventQueue
+{
+public:
+    static_assert(CAPACITY && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+    explicit KeyEventQueue(uint32_t lockoutUs)
+        : lockoutUs(lockoutUs), stable(0), head(0), count(0), droppedCount(0), changeUs{}
+    {
+    }
+
+    /**
+     * @brief Feeds one key scan.
+     *
+     * @param keys  Bit n set while key n is held.
+     * @param nowUs micros() at the scan.
+     */
+    void scan(uint8_t keys, uint32_t nowUs)
+    {
+        uint8_t changed = keys ^ stable;
+        for (uint8_t key = 0; changed; key++, changed >>= 1)
+        {
+            if (!(changed & 1) || nowUs - changeUs[key] < lockoutUs)
+                continue;
+
+            uint8_t bit = 1 << key;
+            stable ^= bit;
+            changeUs[key] = nowUs;
+            if (keys & bit)
+                push(KeyEvent{key, nowUs});
+        }
+    }
+
+    /**
+     * @brief Takes the oldest event.
+     *
+     * @return false if the queue is empty.
+     */
+    bool pop(KeyEvent &event)
+    {
+        if (!peek(event))
+            return false;
+        head = (head + 1) & (CAPACITY - 1);
+        count--;
+        return true;
+    }
+
+    /**
+     * @brief Reads a queued event without taking it.
+     *
+     * @param index 0 for the oldest event, 1 for the one after it, ...
+     * @return false if fewer events are queued.
+     */
+    bool peek(KeyEvent &event, uint8_t index = 0) const
+    {
+        if (index >= count)
+            return false;
+        event = events[(head + index) & (CAPACITY - 1)];
+        return true;
+    }
+
+    /**
+     * @brief Drops the queued events. Keys still held do not fire again.
+     */
+    void clear() { count = 0; }
+
+    uint8_t size() const { return count; }
+
+    /** @brief Debounced key levels */
+    uint8_t held() const { return stable; }
+
+    /** @brief Presses lost to a full queue */
+    uint16_t dropped() const { return droppedCount; }
+
+private:
+    void push(const KeyEvent &event)
+    {
+        if (count == CAPACITY)
+        {
+            droppedCount++;
+            return;
+        }
+        events[(head + count) & (CAPACITY - 1)] = event;
+        count++;
+    }
+
+    uint32_t lockoutUs;
+    uint8_t stable;
+    uint8_t head;
+    uint8_t count;
+    uint16_t droppedCount;
+    uint32_t changeUs[8];
+    KeyEvent events[CAPACITY];
+};
+
+#endif // KEY_EVENTS_H
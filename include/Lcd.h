@@ -0,0 +1,87 @@
+#ifndef LCD_H
+#define LCD_H
+
+#include <LiquidCrystal_I2C.h>
+#include "Assets.h"
+
+/**
+ * @class Lcd
+ * @brief The 16x2 I2C character LCD used by every game.
+ *
+ * Thin layer over LiquidCrystal_I2C that accounts each transfer in the bus
+ * statistics. All print() overloads end up in write(), the remaining commands
+ * are shadowed here.
+ */
+class Lcd : public LiquidCrystal_I2C
+{
+public:
+    /**
+     * @brief Constructs an Lcd object.
+     *
+     * @param address I2C address of the PCF8574 backpack.
+     * @param cols    Number of columns.
+     * @param rows    Number of rows.
+     */
+    Lcd(uint8_t address, uint8_t cols, uint8_t rows);
+
+    /**
+     * @brief Clears the display and moves the cursor home.
+     */
+    void clear();
+
+    /**
+     * @brief Moves the cursor to the top-left position.
+     */
+    void home();
+
+    /**
+     * @brief Moves the cursor to the given position.
+     *
+     * @param col Column (0-based).
+     * @param row Row (0-based).
+     */
+    void setCursor(uint8_t col, uint8_t row);
+
+    /**
+     * @brief Uploads a custom character to CGRAM.
+     *
+     * @param location CGRAM slot (0-7).
+     * @param charmap  8-byte bitmap.
+     */
+    void createChar(uint8_t location, uint8_t charmap[]);
+
+    /**
+     * @brief Uploads a custom character from the asset table to CGRAM.
+     *
+     * @param location CGRAM slot (0-7).
+     * @param glyph    Bitmap to upload.
+     */
+    void createChar(uint8_t location, GlyphId glyph);
+
+    /**
+     * @brief Prints a UI string from the asset table at the cursor position.
+     *
+     * @param id String to print.
+     * @return Number of characters written.
+     */
+    size_t print(StringId id);
+
+    using LiquidCrystal_I2C::print;
+
+    /**
+     * @brief Writes one character at the cursor position.
+     */
+    size_t write(uint8_t value) override;
+
+    using LiquidCrystal_I2C::write;
+
+    /**
+     * @brief Number of clear() calls so far, tells a caller whether what it drew was wiped.
+     */
+    uint16_t clears() const { return clearCount; }
+
+private:
+    uint16_t clearCount;
+};
+
+#endif // LCD_H
@@ -0,0 +1,63 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "BinLog.h"
+
+/**
+ * @brief Compile-time filtered logging on top of BinLog.
+ *
+ * Every module has its own level, set with -DLOG_LEVEL_<MODULE>=... in
+ * platformio.ini and defaulting to LOG_LEVEL_DEFAULT. A statement above its
+ * module's level is discarded with if constexpr: its arguments are never
+ * evaluated and no code is emitted for it.
+ *
+ *   LOG_DEBUG(ESCAPE, EscapeGateRange, gateLevel, minVel, maxVel);
+ *
+ * Use LOG_ENABLED(module, level) in #if blocks for work that only feeds a log
+ * statement.
+ */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_DEFAULT LOG_LEVEL_INFO
+#endif
+
+// Per-module levels
+#ifndef LOG_LEVEL_SYSTEM
+#define LOG_LEVEL_SYSTEM LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_RUNNER
+#define LOG_LEVEL_RUNNER LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_MEMORY
+#define LOG_LEVEL_MEMORY LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_ESCAPE
+#define LOG_LEVEL_ESCAPE LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_ARCHERY
+#define LOG_LEVEL_ARCHERY LOG_LEVEL_DEFAULT
+#endif
+
+#define LOG_ENABLED(module, level) (LOG_LEVEL_##module >= LOG_LEVEL_##level)
+
+#define LOG(module, level, format, ...)                                \
+    do                                                                 \
+    {                                                                  \
+        if constexpr (LOG_ENABLED(module, level))                      \
+        {                                                              \
+            BinLog::log(LogFormat::format, ##__VA_ARGS__);             \
+        }                                                              \
+    } while (0)
+
+#define LOG_ERROR(module, format, ...) LOG(module, ERROR, format, ##__VA_ARGS__)
+#define LOG_WARN(module, format, ...) LOG(module, WARN, format, ##__VA_ARGS__)
+#define LOG_INFO(module, format, ...) LOG(module, INFO, format, ##__VA_ARGS__)
+#define LOG_DEBUG(module, format, ...) LOG(module, DEBUG, format, ##__VA_ARGS__)
+
+#endif // LOG_H
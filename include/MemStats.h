@@ -0,0 +1,98 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <Arduino.h>
+
+#ifndef MEM_REPORT_INTERVAL_MS
+/** @brief Period of the RAM report in the binary log, 0 disables it */
+#define MEM_REPORT_INTERVAL_MS 0
+#endif
+
+/**
+ * @brief RAM usage: static sections, heap, and the stack high-water mark.
+ *
+ * begin() paints the free RAM between the heap and the stack with a known
+ * pattern. The stack grows down into it, so the lowest overwritten word is
+ * the deepest the stack has ever been. The static sections come from the
+ * linker script symbols (.data, .bss, end of heap, top of stack).
+ *
+ * Host builds run the same accounting against a simulated RAM image
+ * instead of the linker symbols.
+ */
+namespace MemStats
+{
+    /** @brief Value painted into unused stack words */
+    constexpr uint32_t PAINT_PATTERN = 0xC5C5C5C5;
+
+    /** @brief Words left unpainted below the stack pointer at begin() */
+    constexpr uint32_t PAINT_MARGIN_WORDS = 16;
+
+    /**
+     * @brief Word range, the stack grows down from high towards low.
+     */
+    struct Region
+    {
+        uint32_t *low;
+        uint32_t *high;
+    };
+
+    /**
+     * @brief RAM breakdown in bytes.
+     */
+    struct Report
+    {
+        uint32_t dataBytes;      ///< Initialised statics (.data)
+        uint32_t bssBytes;       ///< Zeroed statics (.bss)
+        uint32_t heapBytes;      ///< Heap handed out by sbrk so far
+        uint32_t stackPeakBytes; ///< Deepest stack use since begin()
+        uint32_t headroomBytes;  ///< Never touched between heap and stack
+        uint32_t totalBytes;     ///< Whole RAM region
+    };
+
+    /**
+     * @brief Fills a region with PAINT_PATTERN.
+     */
+    void paint(const Region &region);
+
+    /**
+     * @brief Bytes at the low end of a region that still hold the pattern.
+     */
+    uint32_t untouchedBytes(const Region &region);
+
+    /**
+     * @brief Paints the free RAM below the current stack pointer.
+     *
+     * Call first thing in setup(), takes about a millisecond.
+     */
+    void begin();
+
+    /**
+     * @brief Measures the current breakdown.
+     *
+     * Scans the painted region, about a millisecond.
+     */
+    Report report();
+
+    /**
+     * @brief Prints the breakdown.
+     */
+    void print(Print &out);
+
+    /**
+     * @brief Logs the breakdown every MEM_REPORT_INTERVAL_MS, call once per loop().
+     */
+    void poll();
+
+#ifndef ARDUINO
+    /** @brief Host builds: size of the simulated RAM */
+    constexpr uint32_t SIMULATED_RAM_BYTES = 16 * 1024;
+
+    /**
+     * @brief Host builds: simulated RAM. .data is the first KB, .bss the next
+     * 2 KB and the heap 1 KB; the stack grows down from the top to 4 KB.
+     */
+    extern uint32_t simulatedRam[SIMULATED_RAM_BYTES / 4];
+#endif
+}
+
+#endif // MEM_STATS_H
@@ -2,6 +2,8 @@
 #define MEMORY_GAME_H
 
 #include "BaseGame.h"
+#include "KeyEvents.h"
+#include "PackedSequence.h"
 #include <Arduino.h>
 
 /**
@@ -19,11 +21,23 @@ namespace MemoryGameConfig
     /** @brief Initial sequence length at level 1 */
     constexpr int INITIAL_SEQUENCE_LENGTH = 2;
     
-    /** @brief Maximum size of the sequence array */
+    /** @brief Maximum number of steps in a sequence */
     constexpr int MAX_SEQUENCE_SIZE = 32;
     
     /** @brief Number of LEDs/buttons in the game */
     constexpr int NUM_LEDS = 8;
+
+    /** @brief Bits per stored sequence step, enough for an LED index */
+    constexpr uint8_t SEQUENCE_BITS = 3;
+
+    /** @brief Longest run of one LED allowed in a sequence */
+    constexpr uint8_t MAX_REPEAT = 3;
+
+    /** @brief Default for MemoryAppendMode: 0 draws a new sequence per level, 1 keeps it and appends */
+    constexpr int APPEND_MODE = 0;
+
+    /** @brief Steps added per level in append mode */
+    constexpr int APPEND_STEPS_PER_LEVEL = 1;
     
     /** @brief Sequence length for levels 3-4 */
     constexpr int LEVEL_2_SEQUENCE_LENGTH = 3;
@@ -49,9 +63,6 @@ namespace MemoryGameConfig
     /** @brief Mask for all LEDs (0xFF) */
     constexpr int ALL_LEDS_MASK = 0xFF;
     
-    /** @brief Value indicating no button is pressed */
-    constexpr int NO_BUTTON_PRESSED = -1;
-    
     /** @brief Number of blinks required in the start animation */
     constexpr int REQUIRED_BLINKS = 2;
 
@@ -71,8 +82,14 @@ namespace MemoryGameConfig
     /** @brief Duration for which finish state is displayed */
     constexpr unsigned long FINISH_DISPLAY_TIME = 1000;
     
-    /** @brief Delay for button debouncing */
-    constexpr unsigned long BUTTON_DEBOUNCE_DELAY = 200;
+    /** @brief A key's level is held this long after it changes, to ride out contact bounce */
+    constexpr uint32_t KEY_LOCKOUT_US = 30000;
+
+    /** @brief Key presses queued while the feedback of the previous one plays */
+    constexpr uint8_t KEY_QUEUE_SIZE = 16;
+
+    /** @brief Default for MemoryChordWindowMs, 0 turns the chord rule off */
+    constexpr int CHORD_WINDOW_MS = 0;
     
     /** @brief Base delay between rounds */
     constexpr unsigned long ROUND_CONFIG_BASE_DELAY = 1000;
@@ -99,25 +116,35 @@ namespace MemoryGameConfig
     /** @brief Duration of start tone */
     constexpr int START_TONE_DURATION = 300;
 
+    // Adaptive tempo (MemoryTempo)
+    /** @brief Default for MemoryTempoMinPercent, fastest playback relative to the nominal times */
+    constexpr int TEMPO_MIN_PERCENT = 60;
+
+    /** @brief Default for MemoryTempoMaxPercent, slowest playback relative to the nominal times */
+    constexpr int TEMPO_MAX_PERCENT = 150;
+
+    /** @brief Average response below this counts as fast */
+    constexpr uint16_t TEMPO_FAST_LATENCY_MS = 700;
+
+    /** @brief Average response above this counts as struggling */
+    constexpr uint16_t TEMPO_SLOW_LATENCY_MS = 1500;
+
+    /** @brief Error rate below which a fast group is sped up */
+    constexpr uint16_t TEMPO_LOW_ERROR_PERMILLE = 250;
+
+    /** @brief Tempo change after a clean fast round */
+    constexpr uint16_t TEMPO_SPEEDUP_PERMILLE = 100;
+
+    /** @brief Tempo change after an error or a slow round */
+    constexpr uint16_t TEMPO_SLOWDOWN_PERMILLE = 150;
+
     // Start animation blink interval
     /** @brief Interval between blinks in the start animation */
     constexpr unsigned long START_ANIM_INTERVAL = 200;
-    
-    // Display messages
-    /** @brief Title displayed at the start of the game */
-    constexpr const char* GAME_TITLE = "Memory Mole!";
-    
-    /** @brief Message displayed at the start of the game */
-    constexpr const char* GOOD_LUCK_MESSAGE = "Good luck";
-    
-    /** @brief Message displayed when user makes a mistake */
-    constexpr const char* ERROR_MESSAGE = "ERROR!";
-    
-    /** @brief Message displayed when user completes the game */
-    constexpr const char* SUCCESS_MESSAGE = "GOOD";
-    
-    /** @brief Message displayed after an error */
-    constexpr const char* WATCH_CAREFULLY_MESSAGE = "Watch carefully!";
+
+    static_assert(NUM_LEDS <= (1 << SEQUENCE_BITS), "an LED index must fit SEQUENCE_BITS");
+    static_assert(INITIAL_SEQUENCE_LENGTH + (MAX_LEVEL - 1) * APPEND_STEPS_PER_LEVEL <= MAX_SEQUENCE_SIZE,
+                  "append mode outgrows the sequence");
 }
 
 /**
@@ -132,6 +159,57 @@ namespace Frequencies
     constexpr int ledFrequencies[MemoryGameConfig::NUM_LEDS] = {220, 262, 294, 330, 349, 392, 440, 494};
 }
 
+/**
+ * @brief Playback tempo of the Memory Game, adapted to the players.
+ *
+ * Tracks the response time per step and the share of failed rounds as
+ * moving averages, and scales the sequence on/off times once per round:
+ * an error or a slow round stretches them, a clean round with fast
+ * responses and few recent errors shortens them. The scale stays within
+ * the bounds given to begin(); equal bounds give a fixed tempo.
+ */
+class MemoryTempo
+{
+public:
+    MemoryTempo();
+
+    /**
+     * @brief Starts a session at the nominal tempo.
+     *
+     * @param minPercent Fastest scale, in percent of the nominal times.
+     * @param maxPercent Slowest scale.
+     */
+    void begin(int minPercent, int maxPercent);
+
+    /**
+     * @brief Records how long the players took for one step.
+     */
+    void recordResponse(unsigned long responseMs);
+
+    /**
+     * @brief Adapts the tempo at the end of a round.
+     *
+     * @param failed The round ended with a wrong button.
+     */
+    void endRound(bool failed);
+
+    /**
+     * @brief A nominal duration at the current tempo.
+     */
+    unsigned long scale(unsigned long nominalMs) const { return nominalMs * scalePermille / 1000; }
+
+    uint16_t getScalePermille() const { return scalePermille; }
+    uint16_t getLatencyMs() const { return latencyMs; }
+    uint16_t getErrorRatePermille() const { return errorRatePermille; }
+
+private:
+    uint16_t minPermille;
+    uint16_t maxPermille;
+    uint16_t scalePermille;     ///< Current on/off time scale, 1000 is nominal
+    uint16_t latencyMs;         ///< Moving average of the response time per step
+    uint16_t errorRatePermille; ///< Moving average of failed rounds
+};
+
 /**
  * @brief Game states for the Memory Game.
  *
@@ -255,6 +333,26 @@ public:
      */
     bool run() override;
 
+    /**
+     * @brief Returns the current game state as a raw value.
+     */
+    uint8_t getStateCode() const override { return static_cast<uint8_t>(currentState); }
+
+    /**
+     * @brief Current level, 0 before the game has started.
+     */
+    uint32_t getProgress() const override { return level; }
+
+    /**
+     * @brief Starts the next game at a checkpointed level.
+     */
+    void resumeFrom(uint32_t progress) override;
+
+    /**
+     * @brief Returns the game to its initial state, the next run() starts it over.
+     */
+    void reset() override;
+
 private:
     // State variables
     /** @brief Current state of the game */
@@ -277,19 +375,19 @@ private:
 
     /** @brief Current level of the game */
     int level;
+
+    /** @brief Level the next startGame() begins at */
+    int startLevel;
     
     /** @brief Length of the current sequence */
     int seqLength;
     
-    /** @brief Array storing the current sequence */
-    int sequence[MemoryGameConfig::MAX_SEQUENCE_SIZE];
+    /** @brief Current sequence, one LED index per step */
+    PackedSequence<MemoryGameConfig::SEQUENCE_BITS, MemoryGameConfig::MAX_SEQUENCE_SIZE> sequence;
     
     /** @brief Current index in the user's input sequence */
     int userIndex;
     
-    /** @brief Last button pressed by the user */
-    int lastButtonPressed;
-    
     /** @brief Count of blinks in the start animation */
     int blinkCount;
     
@@ -303,8 +401,8 @@ private:
     /** @brief Time of the last action */
     unsigned long lastActionTime;
     
-    /** @brief Time of the last button press */
-    unsigned long lastPressTime;
+    /** @brief micros() of the last press, or of the end of the playback before the first one */
+    uint32_t lastInputUs;
     
     /** @brief Start time of input delay */
     unsigned long inputDelayStart;
@@ -321,6 +419,12 @@ private:
     /** @brief Current index in the sequence display */
     int seqDisplayIndex;
 
+    /** @brief Playback tempo, adapted after every round */
+    MemoryTempo tempo;
+
+    /** @brief Key presses in the order they happened, scanned every tick */
+    KeyEventQueue<MemoryGameConfig::KEY_QUEUE_SIZE> keyEvents;
+
     // Private helper functions
     /**
      * @brief Sets the game state and updates the state change time.
@@ -348,11 +452,18 @@ private:
     void update7SegmentDisplay() const;
     
     /**
-     * @brief Generates a random sequence of the given length.
-     * 
+     * @brief Brings the sequence to the given length.
+     *
+     * Draws a new sequence, or in append mode extends the current one.
+     *
      * @param length The length of the sequence to generate
      */
     void generateSequence(int length);
+
+    /**
+     * @brief Draws the next step, never a (MAX_REPEAT + 1)th repeat of the last one.
+     */
+    uint8_t nextStep() const;
     
     /**
      * @brief Updates the start animation.
@@ -372,7 +483,7 @@ private:
     void updateSequenceDisplay();
     
     /**
-     * @brief Checks for user input and processes it.
+     * @brief Takes the next queued key press and checks it against the sequence.
      */
     void checkUserInput();
     
@@ -380,6 +491,13 @@ private:
      * @brief Handles the round win condition.
      */
     void handleRoundWin();
+
+    /**
+     * @brief Adapts the tempo to the round just played and logs the decision.
+     *
+     * @param failed The round ended with a wrong button.
+     */
+    void adaptTempo(bool failed);
     
     // Helper methods for visual feedback
     /**
@@ -0,0 +1,92 @@
+#ifndef PACKED_SEQUENCE_H
+#define PACKED_SEQUENCE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Append-only sequence of small values packed BITS to an entry.
+ *
+ * Entries are stored back to back in a byte array, so an entry can straddle
+ * two bytes; one spare byte at the end lets every access read and write a
+ * 16-bit window. Indexing and appending are O(1). The length of the run of
+ * equal values at the end is kept up to date on append, so rules like "no
+ * four in a row" need no scan.
+ *
+ * @tparam BITS     Bits per entry, 1 to 8.
+ * @tparam CAPACITY Maximum number of entries.
+ */
+template <uint8_t BITS, uint16_t CAPACITY>
+class PackedSequence
+{
+public:
+    static_assert(BITS >= 1 && BITS <= 8, "an entry must fit a 16-bit window at any bit offset");
+
+    static constexpr uint8_t MAX_VALUE = (1 << BITS) - 1;
+    static constexpr uint16_t BYTES = (CAPACITY * BITS + 7) / 8 + 1;
+
+    PackedSequence() : data{}, count(0), run(0) {}
+
+    uint16_t size() const { return count; }
+    bool full() const { return count == CAPACITY; }
+
+    void clear()
+    {
+        count = 0;
+        run = 0;
+    }
+
+    /**
+     * @brief Entry at an index below size().
+     */
+    uint8_t operator[](uint16_t index) const
+    {
+        uint16_t bit = index * BITS;
+        uint16_t window = data[bit / 8] | (data[bit / 8 + 1] << 8);
+        return (window >> (bit % 8)) & MAX_VALUE;
+    }
+
+    /**
+     * @brief Last entry, 0 if the sequence is empty.
+     */
+    uint8_t back() const { return count ? (*this)[count - 1] : 0; }
+
+    /**
+     * @brief Number of entries at the end equal to back(), saturating at 255.
+     */
+    uint8_t trailingRun() const { return run; }
+
+    /**
+     * @brief Adds an entry at the end.
+     *
+     * @param value Value to add, only the low BITS bits are kept.
+     * @return false if the sequence is full.
+     */
+    bool append(uint8_t value)
+    {
+        if (full())
+            return false;
+
+        value &= MAX_VALUE;
+        if (count && value == back())
+            run = run < UINT8_MAX ? run + 1 : run;
+        else
+            run = 1;
+
+        uint16_t bit = count * BITS;
+        uint8_t shift = bit % 8;
+        uint16_t mask = (uint16_t)MAX_VALUE << shift;
+        uint16_t window = data[bit / 8] | (data[bit / 8 + 1] << 8);
+        window = (window & ~mask) | ((uint16_t)value << shift);
+        data[bit / 8] = window & 0xFF;
+        data[bit / 8 + 1] = window >> 8;
+        count++;
+        return true;
+    }
+
+private:
+    uint8_t data[BYTES];
+    uint16_t count;
+    uint8_t run;
+};
+
+#endif // PACKED_SEQUENCE_H
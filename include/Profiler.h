@@ -0,0 +1,124 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "CycleCounter.h"
+
+/**
+ * @brief Code regions measured by the profiler.
+ */
+enum class ProfileZone : uint8_t
+{
+    Loop,         ///< One full iteration of loop()
+    RunnerRun,    ///< RunnerGame::run()
+    MemoryRun,    ///< MemoryGame::run()
+    EscapeRun,    ///< EscapeVelocity::run()
+    ArcheryRun,   ///< ArcheryChallenge::run()
+    TimerLcd,     ///< updateTimerOnLCD()
+    WhaddaUpdate, ///< Whadda::update()
+    RgbUpdate,    ///< RGBLed::update()
+    Count
+};
+
+/**
+ * @brief Histogram with one bucket per power of two.
+ *
+ * Bucket n counts samples in [2^n, 2^(n+1)). Counts saturate instead of wrapping.
+ */
+struct Log2Histogram
+{
+    static constexpr uint8_t BUCKETS = 32;
+
+    uint16_t buckets[BUCKETS];
+
+    /**
+     * @brief Returns the bucket index for a sample.
+     */
+    static uint8_t bucketFor(uint32_t value)
+    {
+        return 31 - __builtin_clz(value | 1);
+    }
+
+    void add(uint32_t value)
+    {
+        uint16_t &bucket = buckets[bucketFor(value)];
+        if (bucket != UINT16_MAX)
+            bucket++;
+    }
+
+    /**
+     * @brief Prints the non-empty buckets as "exponent:count" pairs.
+     */
+    void print(Print &out) const;
+};
+
+/**
+ * @brief Cycle-accurate profiler built on the DWT cycle counter.
+ *
+ * Statistics live in static RAM, there is one ZoneStats per ProfileZone.
+ * Everything is compiled in only when ENABLE_PROFILER is defined, otherwise
+ * PROFILE_ZONE() expands to nothing.
+ */
+namespace Profiler
+{
+    /**
+     * @brief Accumulated statistics of a single zone.
+     */
+    struct ZoneStats
+    {
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+        Log2Histogram histogram;
+    };
+
+    /**
+     * @brief Starts the cycle counter and clears all statistics.
+     */
+    void begin();
+
+    /**
+     * @brief Clears all statistics.
+     */
+    void reset();
+
+    /**
+     * @brief Adds one measurement to a zone.
+     *
+     * @param zone   The zone that was measured.
+     * @param cycles Duration in CPU cycles.
+     */
+    void record(ProfileZone zone, uint32_t cycles);
+
+    /**
+     * @brief Prints all zones as a compact table.
+     *
+     * @param out Stream to print to, usually Serial.
+     */
+    void dump(Print &out);
+
+    /**
+     * @brief Measures the lifetime of the object and records it on destruction.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(ProfileZone zone) : _zone(zone), _start(CycleCounter::now()) {}
+        ~Scope() { record(_zone, CycleCounter::now() - _start); }
+
+    private:
+        ProfileZone _zone;
+        uint32_t _start;
+    };
+}
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -30,6 +30,8 @@ public:
     /**
      * @brief Sets the RGB LED to the specified red, green, and blue intensities.
      *
+     * Cancels a running pulse or blink sequence.
+     *
      * @param redValue   Intensity of the red channel (0-255).
      * @param greenValue Intensity of the green channel (0-255).
      * @param blueValue  Intensity of the blue channel (0-255).
@@ -45,9 +47,24 @@ public:
 
     /**
      * @brief Turns off the RGB LED by setting all channels to zero.
+     *
+     * Cancels a running pulse or blink sequence.
      */
     void off();
 
+    /**
+     * @brief Lights the LED for a while, update() turns it off again.
+     *
+     * Non-blocking replacement for setColor(); delay(); off(). A new pulse,
+     * blink or color replaces a running one.
+     *
+     * @param redValue   Intensity of the red channel (0-255).
+     * @param greenValue Intensity of the green channel (0-255).
+     * @param blueValue  Intensity of the blue channel (0-255).
+     * @param durationMs How long the LED stays on.
+     */
+    void pulse(int redValue, int greenValue, int blueValue, unsigned long durationMs);
+
     /**
      * @brief Blinks the LED a specified number of times.
      *
@@ -69,13 +86,20 @@ public:
     // Call one of these to start a blink sequence.
     void startBlinkCurrent(int count);
     void startBlinkColor(int redValue, int greenValue, int blueValue, int count = 1);
-    // Call update() repeatedly (e.g. in loop()) to process blink transitions.
+    // Call update() repeatedly (e.g. in loop()) to process blink transitions and end pulses.
     void update();
 
 private:
     int _redPin, _greenPin, _bluePin;
     int _currentRed, _currentGreen, _currentBlue;
 
+    bool _isPulsing;
+    unsigned long _pulseStart;
+    unsigned long _pulseDuration;
+
+    // Drives the pins without touching the running effect
+    void writeColor(int redValue, int greenValue, int blueValue);
+
     bool _isBlinking;
     int _blinkCount;  // Remaining transitions (on/off)
     bool _blinkState; // Current state: true means LED is on, false means off
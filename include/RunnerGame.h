@@ -2,6 +2,9 @@
 #define RUNNER_GAME_H
 
 #include "BaseGame.h"
+#include "Assets.h"
+#include "RunnerSchedule.h"
+#include "Profiler.h"
 #include <Arduino.h>
 
 /**
@@ -16,93 +19,37 @@ namespace RunnerGameConfig
     constexpr int LCD_COLS = 16;
     constexpr int LCD_ROWS = 2;
 
-    // Custom character IDs
-    constexpr int LLAMA_STANDING_PART1_ID = 0;
-    constexpr int LLAMA_STANDING_PART2_ID = 1;
-    constexpr int LLAMA_RIGHT_FOOT_PART1_ID = 2;
-    constexpr int LLAMA_RIGHT_FOOT_PART2_ID = 3;
-    constexpr int LLAMA_LEFT_FOOT_PART1_ID = 4;
-    constexpr int LLAMA_LEFT_FOOT_PART2_ID = 5;
-    constexpr int CACTUS_PART1_ID = 6;
-    constexpr int CACTUS_PART2_ID = 7;
+    // Custom characters (bitmaps live in Assets, the CGRAM slot layout is in RunnerGame.cpp)
+    constexpr int CGRAM_SLOTS = 8;
+    constexpr int CELL_PIXELS = 5;   // Pixel columns per character cell
 
-    // Custom character bitmaps
-    /**
-     * @brief Bitmap for the standing llama character (part 1)
-     * 
-     * Custom character bitmap for the first part of the standing llama.
-     * Used when the llama is not moving or during jumps.
-     */
-    inline byte llamaStandingPart1[8] = {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00011};
-
-    /**
-     * @brief Bitmap for the standing llama character (part 2)
-     * 
-     * Custom character bitmap for the second part of the standing llama.
-     * Used when the llama is not moving or during jumps.
-     */
-    inline byte llamaStandingPart2[8] = {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B11000};
-
-    /**
-     * @brief Bitmap for the llama with right foot forward (part 1)
-     * 
-     * Custom character bitmap for the first part of the llama with right foot forward.
-     * Used in the running animation sequence.
-     */
-    inline byte llamaRightFootPart1[8] = {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00011};
-
-    /**
-     * @brief Bitmap for the llama with right foot forward (part 2)
-     * 
-     * Custom character bitmap for the second part of the llama with right foot forward.
-     * Used in the running animation sequence.
-     */
-    inline byte llamaRightFootPart2[8] = {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B00000};
-
-    /**
-     * @brief Bitmap for the llama with left foot forward (part 1)
-     * 
-     * Custom character bitmap for the first part of the llama with left foot forward.
-     * Used in the running animation sequence.
-     */
-    inline byte llamaLeftFootPart1[8] = {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00000};
-
-    /**
-     * @brief Bitmap for the llama with left foot forward (part 2)
-     * 
-     * Custom character bitmap for the second part of the llama with left foot forward.
-     * Used in the running animation sequence.
-     */
-    inline byte llamaLeftFootPart2[8] = {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B11000};
-
-    /**
-     * @brief Bitmap for the cactus obstacle (part 1)
-     * 
-     * Custom character bitmap for the first part of the cactus obstacle.
-     */
-    inline byte cactusPart1[8] = {B00000, B00100, B00100, B10100, B10100, B11100, B00100, B00100};
-
-    /**
-     * @brief Bitmap for the cactus obstacle (part 2)
-     * 
-     * Custom character bitmap for the second part of the cactus obstacle.
-     */
-    inline byte cactusPart2[8] = {B00100, B00101, B00101, B10101, B11111, B00100, B00100, B00100};
+    // Sub-cell scrolling: obstacles move one pixel column per frame while the I2C bus keeps up
+    constexpr uint8_t MAX_SUB_STEPS = CELL_PIXELS;     // Frames per cell at most, one per pixel column
+    constexpr uint16_t UPLOAD_BUDGET_PERMILLE = 750;   // Share of a tick the glyph uploads may take
+    constexpr uint32_t INITIAL_UPLOAD_US = 11000;      // One createChar at 100 kHz, refined by measurement
 
     // Game mechanics
-    constexpr int INITIAL_CACTUS_POS = 15;
+    constexpr int OBSTACLE_SPAWN_COL = 15;
     constexpr int GROUND_ROW = 1;
     constexpr int JUMP_ROW = 0;
     constexpr int MIN_JUMP_DURATION = 200;  // ms
+    constexpr int JUMP_BUFFER_MS = 150;     // A press in the air fires on landing if this recent (tuning default)
+    constexpr int COYOTE_TIME_MS = 60;      // A press this late after a hit still jumps (tuning default)
     constexpr int NUM_OBSTACLE_TYPES = 3;   // 0 = bird, 1 = cactus type 1, 2 = cactus type 2
+    constexpr int MAX_OBSTACLES = 4;        // Obstacle ring capacity, a power of two
+    constexpr int MIN_OBSTACLE_GAP = 5;     // Cells between two spawns, room to land and jump again
+    constexpr uint16_t LLAMA_MASK = 0x0001; // Lane mask bit of the llama's leading cell (column 0)
     constexpr int ANIMATION_INTERVAL = 150; // ms
     constexpr int ANIMATION_STATES = 3;     // Number of animation states (0, 1, 2)
 
-    // Speed settings
-    constexpr unsigned long INITIAL_GAME_INTERVAL = 200;    // ms
-    constexpr unsigned long MIN_GAME_INTERVAL = 100;        // ms
-    constexpr unsigned long SPEED_INCREASE_INTERVAL = 5000; // ms - increase speed every 5 seconds
-    constexpr float SPEED_INCREASE_FACTOR = 0.9;            // 10% faster each time
+    // Speed settings (the curve over time is in RunnerSchedule.h)
+    constexpr unsigned long INITIAL_GAME_INTERVAL = 200; // ms, speed level 0
+    constexpr unsigned long MIN_GAME_INTERVAL = 100;     // ms, levels never go faster
+    constexpr int SPEED_INCREASE_PERMILLE = 900;         // 10% faster each level
+
+    // Simulation and render pacing
+    constexpr uint8_t MAX_CATCH_UP_STEPS = 4;      // Steps simulated in one run() after a stall, older ones are dropped
+    constexpr unsigned long RENDER_INTERVAL = 20;  // ms, the LCD is redrawn at most this often
 
     // Timing constants (ms)
     constexpr unsigned long JUMP_DURATION = 600;
@@ -110,13 +57,6 @@ namespace RunnerGameConfig
     constexpr unsigned long WIN_STATE_DURATION = 2000; // 2 seconds for winning state
     constexpr unsigned long RESTART_DELAY = 2000;      // 2 seconds delay before auto-restart
 
-    // Game messages
-    constexpr const char *WELCOME_MSG_LINE1 = "Runner Game";
-    constexpr const char *WELCOME_MSG_LINE2 = "Press jump btn";
-    constexpr const char *GAME_OVER_MSG = "GAME OVER!";
-    constexpr const char *WIN_MSG_LINE1 = "YOU WIN!";
-    constexpr const char *WIN_MSG_LINE2 = "Survived 1 min";
-
     // Sound effects
     constexpr int JUMP_SOUND_FREQ = 800;
     constexpr int JUMP_SOUND_DURATION = 100;
@@ -164,13 +104,59 @@ enum class RunnerGameState
  *
  * This enum class defines the different types of obstacles that can appear in the game.
  */
-enum class ObstacleType
+enum class ObstacleType : uint8_t
 {
-    Bird,
-    CactusType1,
-    CactusType2
+    Bird,        // One cell in the jump row, stay on the ground
+    CactusType1, // Two cells on the ground
+    CactusType2  // One cell on the ground
 };
 
+/**
+ * @brief An obstacle on screen.
+ *
+ * Every obstacle moves one cell per tick, so its column follows from the
+ * tick it spawned at and is not stored.
+ */
+struct RunnerObstacle
+{
+    ObstacleType type;
+    uint16_t spawnTick;
+};
+
+/**
+ * @brief CGRAM upload cost of the Runner Game scrolling.
+ *
+ * Collected per run to check that the I2C bus keeps up with the pixel
+ * scrolling at the fastest speed.
+ */
+struct RunnerFrameStats
+{
+    uint32_t frames;     ///< Frames that uploaded at least one glyph
+    uint32_t uploads;    ///< Glyphs uploaded
+    uint32_t maxFrameUs; ///< Upload time of the slowest frame
+    uint8_t minSubSteps; ///< Fewest frames per cell the upload budget allowed
+};
+
+#ifdef ENABLE_RUNNER_OBSERVER
+/**
+ * @brief Read-only snapshot of the Runner world for test harnesses.
+ *
+ * Only built with ENABLE_RUNNER_OBSERVER, the game never reads it.
+ */
+struct RunnerView
+{
+    RunnerGameState state;
+    uint16_t laneMask[RunnerGameConfig::LCD_ROWS]; ///< Bit n set if an obstacle starts in column n
+    uint8_t obstacleCount;
+    int llamaRow;
+    bool isJumping;
+    uint8_t speedLevel;         ///< Current RunnerSchedule level
+    unsigned long gameInterval; ///< Current tick interval
+    unsigned long score;
+    unsigned long gameStartTime;
+};
+#endif
+
 /**
  * @brief Runner Game class.
  *
@@ -199,19 +185,77 @@ public:
      */
     bool run() override;
 
+    /**
+     * @brief Returns the current game state as a raw value.
+     */
+    uint8_t getStateCode() const override { return static_cast<uint8_t>(currentState); }
+
+    /**
+     * @brief Returns the game to its initial state, the next run() starts it over.
+     */
+    void reset() override;
+
+    /**
+     * @brief Glyph upload cost of the current or last run.
+     */
+    const RunnerFrameStats &getFrameStats() const { return frameStats; }
+
+#ifdef ENABLE_RUNNER_OBSERVER
+    /**
+     * @brief Fills in a snapshot of the world, for test harnesses.
+     */
+    void observe(RunnerView &view) const;
+#endif
+
+#ifdef ENABLE_JUMP_LATENCY
+    /**
+     * @brief Time from a jump press to the llama drawn in the air, in ms.
+     */
+    Log2Histogram &getJumpLatency() { return jumpLatency; }
+#endif
+
 private:
+    /** @brief Content of every LCD cell: a CGRAM slot or a space */
+    typedef uint8_t Frame[RunnerGameConfig::LCD_ROWS][RunnerGameConfig::LCD_COLS];
+
     RunnerGameState currentState;
-    unsigned long lastUpdateTime;
+    unsigned long simTime;               // Time the simulation has been stepped up to
     unsigned long gameStartTime;
-    int cactusPos;
     int llamaRow;
     bool isJumping;
     unsigned long jumpStartTime;
     bool jumpButtonReleased;
+    bool jumpRequested;                  // Press waiting for a step, buffered while in the air
+    unsigned long jumpPressTime;         // When the waiting press began
+    bool collisionPending;               // A step hit the llama on the ground, a late press may still save it
+    unsigned long collisionTime;         // Simulated time of that step
     unsigned long score;
-    ObstacleType currentObstacleType;    // Track which obstacle type is currently displayed
+    RunnerObstacle obstacles[RunnerGameConfig::MAX_OBSTACLES]; // Ring buffer, oldest (leftmost) first
+    uint8_t obstacleHead;                // Index of the oldest obstacle
+    uint8_t obstacleCount;               // Obstacles on screen
+    uint16_t laneMask[RunnerGameConfig::LCD_ROWS]; // Per row, bit n set if an obstacle starts in column n
+    uint16_t worldTick;                  // Obstacle steps since the run started
+    uint8_t ticksToSpawn;                // Steps until the next obstacle enters
+    uint8_t patternIndex;                // Spawn pattern being played
+    uint8_t patternStep;                 // Next step within the pattern
+    uint8_t cgram[RunnerGameConfig::CGRAM_SLOTS][8]; // Bitmaps last uploaded, unchanged slots are not sent again
+    Frame shownCells;                    // What each LCD cell shows, a CGRAM slot or a space
+    uint8_t slotsInUse;                  // Bit n set if CGRAM slot n is needed by the llama or an obstacle on screen
+    uint8_t subSteps;                    // Frames per cell at the current speed and upload cost
+    uint8_t pixelShift;                  // Pixel columns the obstacles are drawn left of their cell
+    uint32_t uploadUs;                   // Running average time of one glyph upload
+    RunnerFrameStats frameStats;         // Upload cost of this run
+    bool cellsDirty;                     // A step moved something since the last redraw
+    unsigned long lastRenderTime;        // Time of the last LCD update
+#ifdef ENABLE_JUMP_LATENCY
+    Log2Histogram jumpLatency;           // Press to llama on screen, ms
+    bool latencyPending;                 // A jump started that has not been drawn yet
+    unsigned long latencyPressTime;      // Press that started it
+#endif
     unsigned long gameInterval;          // Current game speed interval
-    unsigned long lastSpeedIncreaseTime; // Time of last speed increase
+    uint16_t levelIntervalMs[RunnerSchedule::MAX_LEVEL + 1]; // Tick interval per speed level
+    uint8_t spawnGapPercent;             // Spawn pattern gaps scaled by the schedule
+    uint8_t speedLevel;                  // Schedule level gameInterval comes from
     unsigned long gameOverTime;          // Time when game over occurred
     int animationState;                  // Current animation state (0=standing, 1=right foot, 2=left foot)
     unsigned long lastAnimationTime;     // Time of last animation update
@@ -261,23 +305,89 @@ private:
      */
     bool handleWinningState(unsigned long currentTime);
 
+    /**
+     * @brief Advances the simulation by one fixed step.
+     * @param stepTime    Simulated time of the step in milliseconds.
+     * @param jumpPressed Whether the jump button is pressed.
+     * @return true if collision detected, false otherwise.
+     */
+    bool stepSimulation(unsigned long stepTime, bool jumpPressed);
+
+    /**
+     * @brief Settles a hit that a late press may still turn into a jump.
+     * @param now Current or simulated time in milliseconds.
+     * @return true once the hit stands and the game is over.
+     */
+    bool collisionStands(unsigned long now);
+
+    /**
+     * @brief Takes off, the jump counts from the given time.
+     * @param stepTime Simulated time of the jump in milliseconds.
+     */
+    void startJump(unsigned long stepTime);
+
     /**
      * @brief Updates the jump state based on button input.
-     * @param currentTime Current time in milliseconds.
+     * @param stepTime    Simulated time of the step in milliseconds.
      * @param jumpPressed Whether the jump button is pressed.
      */
-    void updateJumpState(unsigned long currentTime, bool jumpPressed);
+    void updateJumpState(unsigned long stepTime, bool jumpPressed);
 
     /**
      * @brief Updates the game objects (obstacle position, collision detection).
+     * @param stepTime Simulated time of the step in milliseconds.
      * @return true if collision detected, false otherwise.
      */
-    bool updateGameObjects();
+    bool updateGameObjects(unsigned long stepTime);
+
+    /**
+     * @brief Enters the next obstacle of the spawn pattern at the right edge.
+     */
+    void spawnObstacle();
+
+    /**
+     * @brief Forgets what CGRAM holds, the next syncGlyphs() uploads every slot in use.
+     */
+    void loadGlyphs();
+
+    /**
+     * @brief Picks the slots in use and the frames per cell for the next tick.
+     */
+    void planScroll();
+
+    /**
+     * @brief Updates the LCD if something visible changed, at most every RENDER_INTERVAL.
+     * @param currentTime Current time in milliseconds.
+     */
+    void render(unsigned long currentTime);
+
+    /**
+     * @brief Renders the glyphs for the current pixel shift and uploads the changed ones.
+     */
+    void syncGlyphs();
+
+    /**
+     * @brief Puts the cells of one obstacle into a frame.
+     * @param frame    Frame to draw into.
+     * @param obstacle Obstacle to draw.
+     * @param leadOnly Only the cell it is scrolling into.
+     */
+    void drawObstacle(Frame &frame, const RunnerObstacle &obstacle, bool leadOnly);
 
     /**
      * @brief Draws the game graphics on the LCD.
      */
     void drawGameGraphics();
+
+    /**
+     * @brief Sends the cells of a frame that differ from what the LCD shows.
+     */
+    void showFrame(const Frame &frame);
+
+    /**
+     * @brief Logs the glyph upload cost of the run.
+     */
+    void reportFrameStats();
  
     /**
      * @brief Provides audio feedback for jumping.
@@ -310,10 +420,10 @@ private:
     void showScoreFeedback();
 
     /**
-     * @brief Updates the game speed based on elapsed time.
-     * @param currentTime Current time in milliseconds.
+     * @brief Updates the game speed and spawn density from the schedule.
+     * @param stepTime Simulated time of the step in milliseconds.
      */
-    void updateGameSpeed(unsigned long currentTime);
+    void updateGameSpeed(unsigned long stepTime);
 };
 
 #endif
@@ -0,0 +1,130 @@
+#ifndef RUNNER_SCHEDULE_H
+#define RUNNER_SCHEDULE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Difficulty schedule of the Runner Game, built at compile time.
+ *
+ * The curve is a short list of keyframes. Each one gives a speed level and
+ * a spawn density from a given second on. build() expands it into one entry
+ * per second of play, so a tick only indexes the table. Shape the curve by
+ * editing CURVE:
+ *
+ * - A level that climbs slowly at first gives an ease-in.
+ * - Two keyframes with the same level give a plateau.
+ * - A level that jumps up and drops back a few seconds later gives a spike.
+ *
+ * Levels map to tick intervals through levelInterval(): every level is
+ * RunnerSpeedFactorPermille faster than the one before, clamped to the
+ * minimum interval. The spawn gap percentage scales the gaps of the spawn
+ * patterns. Between keyframes it ramps linearly, while the level steps.
+ */
+namespace RunnerSchedule
+{
+    struct Keyframe
+    {
+        uint8_t second;          ///< First second this keyframe applies to
+        uint8_t level;           ///< Speed level, 0 is the starting speed
+        uint8_t spawnGapPercent; ///< Spawn pattern gaps in percent
+    };
+
+    struct Entry
+    {
+        uint8_t level;
+        uint8_t spawnGapPercent;
+    };
+
+    constexpr uint8_t MAX_LEVEL = 7;
+    constexpr size_t SECONDS = 64; // Past the end, the last second applies
+
+    // One level every 5 s like the original speed-up, patterns tighten from 15 s
+    constexpr Keyframe CURVE[] = {
+        {0, 0, 100},
+        {5, 1, 100},
+        {10, 2, 100},
+        {15, 3, 100},
+        {20, 4, 95},
+        {25, 5, 90},
+        {30, 6, 85},
+        {35, 7, 80},
+        {50, 7, 70},
+    };
+
+    constexpr size_t KEYFRAMES = sizeof(CURVE) / sizeof(CURVE[0]);
+
+    struct Table
+    {
+        Entry entries[SECONDS];
+    };
+
+    /**
+     * @brief Expands CURVE into one entry per second.
+     */
+    constexpr Table build()
+    {
+        Table table{};
+        size_t key = 0;
+        for (size_t second = 0; second < SECONDS; second++)
+        {
+            while (key + 1 < KEYFRAMES && CURVE[key + 1].second <= second)
+                key++;
+
+            const Keyframe &from = CURVE[key];
+            uint8_t gap = from.spawnGapPercent;
+            if (key + 1 < KEYFRAMES)
+            {
+                const Keyframe &to = CURVE[key + 1];
+                int span = to.second - from.second;
+                int delta = (int)to.spawnGapPercent - (int)from.spawnGapPercent;
+                gap = (uint8_t)(from.spawnGapPercent + delta * (int)(second - from.second) / span);
+            }
+            table.entries[second] = Entry{from.level, gap};
+        }
+        return table;
+    }
+
+    constexpr Table TABLE = build();
+
+    /**
+     * @brief Schedule entry for a number of seconds into the run.
+     */
+    inline const Entry &at(uint32_t second)
+    {
+        return TABLE.entries[second < SECONDS ? second : SECONDS - 1];
+    }
+
+    /**
+     * @brief Tick interval of a speed level.
+     *
+     * @param level          Speed level.
+     * @param initialMs      Interval at level 0.
+     * @param minMs          Fastest interval allowed.
+     * @param factorPermille Interval multiplier per level.
+     */
+    constexpr uint16_t levelInterval(uint8_t level, uint16_t initialMs, uint16_t minMs, uint16_t factorPermille)
+    {
+        uint32_t interval = initialMs;
+        for (uint8_t i = 0; i < level; i++)
+            interval = interval * factorPermille / 1000;
+        return interval < minMs ? minMs : (uint16_t)interval;
+    }
+
+    constexpr bool curveIsValid()
+    {
+        for (size_t i = 0; i < KEYFRAMES; i++)
+        {
+            if (CURVE[i].level > MAX_LEVEL || CURVE[i].spawnGapPercent == 0)
+                return false;
+            if (i > 0 && CURVE[i].second <= CURVE[i - 1].second)
+                return false;
+        }
+        return CURVE[0].second == 0;
+    }
+
+    static_assert(curveIsValid(), "CURVE must start at second 0, ascend, and stay within MAX_LEVEL");
+    static_assert(levelInterval(1, 200, 100, 900) == 180 && levelInterval(7, 200, 100, 900) == 100, "original speed-up");
+}
+
+#endif // RUNNER_SCHEDULE_H
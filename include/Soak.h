@@ -0,0 +1,29 @@
+#ifndef SOAK_H
+#define SOAK_H
+
+#include <Arduino.h>
+
+#ifndef SOAK_GAMES
+#define SOAK_GAMES 500
+#endif
+
+/**
+ * @brief Unattended soak test of the Runner Game.
+ *
+ * Built only in the soak environment (SOAK defined). An autoplayer reads the
+ * world through RunnerGame::observe() and presses the jump button through
+ * Stimulus, while the game runs on the virtual clock. Results are printed as
+ * JSON lines on Serial, like the benchmark suite.
+ */
+namespace Soak
+{
+    /**
+     * @brief Plays SOAK_GAMES runs and prints the report.
+     *
+     * Call once from setup() after the hardware has been initialized. Game
+     * time is handed back to millis() afterwards.
+     */
+    void run();
+}
+
+#endif // SOAK_H
@@ -0,0 +1,93 @@
+#ifndef STALL_MONITOR_H
+#define STALL_MONITOR_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Detects loop() iterations that exceed a latency budget.
+ *
+ * Every iteration is timestamped; the ones that take longer than the budget are
+ * kept in a small ring buffer together with the active game and its state.
+ * The budget only decides what is recorded. With ENABLE_IWDG the independent
+ * watchdog is petted at the end of a completed iteration, as long as some
+ * iteration within the last PROGRESS_WINDOW_MS was quicker than
+ * PROGRESS_ITERATION_US, so a hung or permanently bogged-down loop resets
+ * the board.
+ *
+ * Compiled in only when ENABLE_STALL_MONITOR is defined, otherwise all
+ * functions are empty inlines.
+ */
+namespace StallMonitor
+{
+    /** @brief Default latency budget for one loop() iteration */
+    constexpr uint32_t DEFAULT_BUDGET_US = 5000;
+
+    /** @brief Iterations slower than this do not count as progress for the watchdog */
+    constexpr uint32_t PROGRESS_ITERATION_US = 250000;
+
+    /** @brief The watchdog is petted only while a progressing iteration ended within this window */
+    constexpr uint32_t PROGRESS_WINDOW_MS = 5000;
+
+    /** @brief Number of stalls kept in the ring buffer */
+    constexpr uint8_t RING_SIZE = 16;
+
+    /** @brief Watchdog timeout, must exceed the longest blocking iteration (win melody + Imperial March) */
+    constexpr uint32_t WATCHDOG_TIMEOUT_US = 20000000;
+
+    /**
+     * @brief One loop() iteration that exceeded the budget.
+     */
+    struct StallRecord
+    {
+        uint32_t timestampMs; ///< millis() when the iteration started
+        uint32_t durationUs;  ///< Duration of the iteration
+        uint8_t game;         ///< Active challenge (0 = none, 1-4)
+        uint8_t state;        ///< Raw state enum value of the active challenge
+    };
+
+#ifdef ENABLE_STALL_MONITOR
+    /**
+     * @brief Sets the budget and starts the watchdog if enabled.
+     *
+     * @param budgetUs Iterations longer than this are recorded.
+     */
+    void begin(uint32_t budgetUs = DEFAULT_BUDGET_US);
+
+    /**
+     * @brief Marks the start of a loop() iteration.
+     */
+    void beginTick();
+
+    /**
+     * @brief Marks the end of a loop() iteration and records it if it stalled.
+     *
+     * @param game  Active challenge number.
+     * @param state Raw state of the active challenge.
+     */
+    void endTick(uint8_t game, uint8_t state);
+
+    /**
+     * @brief Pets the watchdog from an intentional terminal loop (win/game over screens).
+     */
+    void idle();
+
+    /**
+     * @brief Total number of stalls since boot (the ring only keeps the latest ones).
+     */
+    uint32_t stallCount();
+
+    /**
+     * @brief Prints the recorded stalls, oldest first.
+     */
+    void dump(Print &out);
+#else
+    inline void begin(uint32_t = DEFAULT_BUDGET_US) {}
+    inline void beginTick() {}
+    inline void endTick(uint8_t, uint8_t) {}
+    inline void idle() {}
+    inline uint32_t stallCount() { return 0; }
+    inline void dump(Print &) {}
+#endif
+}
+
+#endif // STALL_MONITOR_H
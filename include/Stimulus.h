@@ -0,0 +1,84 @@
+#ifndef STIMULUS_H
+#define STIMULUS_H
+
+#include <Arduino.h>
+#include "Pins.h"
+
+/**
+ * @brief Input layer that lets scripted scenarios stand in for the player.
+ *
+ * Games read the start button, the potentiometer and the TM1638 keys through
+ * these functions. When ENABLE_STIMULUS is defined and a frame is active, the
+ * scripted values are returned instead of the hardware readings. Otherwise the
+ * hardware reading is passed through or read with the Arduino API.
+ */
+namespace Stimulus
+{
+    /**
+     * @brief One frame of scripted input.
+     */
+    struct Frame
+    {
+        bool button;  ///< Start/jump button held down
+        uint8_t keys; ///< TM1638 key bitmask
+        int pot;      ///< Raw potentiometer reading (0-1023)
+    };
+
+#ifdef ENABLE_STIMULUS
+    extern bool active;
+    extern Frame frame;
+
+    /**
+     * @brief Replaces the hardware inputs with the given frame.
+     */
+    inline void apply(const Frame &f)
+    {
+        frame = f;
+        active = true;
+    }
+
+    /**
+     * @brief Hands the inputs back to the hardware.
+     */
+    inline void release()
+    {
+        active = false;
+    }
+
+    inline int level(uint8_t pin, int hardwareLevel)
+    {
+        if (active && pin == BTN_PIN)
+            return frame.button ? LOW : HIGH;
+        return hardwareLevel;
+    }
+
+    inline int analogRead(uint8_t pin)
+    {
+        if (active && pin == POT_PIN)
+            return frame.pot;
+        return ::analogRead(pin);
+    }
+
+    inline uint8_t keys(uint8_t hardwareKeys)
+    {
+        return active ? frame.keys : hardwareKeys;
+    }
+#else
+    inline int level(uint8_t, int hardwareLevel)
+    {
+        return hardwareLevel;
+    }
+
+    inline int analogRead(uint8_t pin)
+    {
+        return ::analogRead(pin);
+    }
+
+    inline uint8_t keys(uint8_t hardwareKeys)
+    {
+        return hardwareKeys;
+    }
+#endif
+}
+
+#endif // STIMULUS_H
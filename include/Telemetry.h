@@ -0,0 +1,112 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Per-session player statistics, kept in flash across resets.
+ *
+ * The games report events (deaths, errors, failed gates, arrows) into the
+ * record of the running session; the sequencer reports challenge changes and
+ * the outcome. A finished record goes into a small RAM ring and is written to
+ * a FlashRecordLog right away, so the log keeps a few hundred sessions. The
+ * console exports them as one binary frame that tools/telemetry_decode.py
+ * turns into CSV.
+ *
+ * Event hooks are a few RAM increments and safe to call from game code.
+ */
+namespace Telemetry
+{
+    constexpr uint8_t CHALLENGES = 4;
+    constexpr uint8_t MEMORY_LEVELS = 8;
+    constexpr uint8_t ARCHERY_ROUNDS = 3;
+
+    /** @brief Finished sessions waiting to be written to flash */
+    constexpr uint8_t RING_SIZE = 4;
+
+    /** @brief Export frame: "TLM", version, record count, record size, records, CRC-32 */
+    constexpr uint8_t EXPORT_VERSION = 1;
+
+    /**
+     * @brief How a session ended.
+     */
+    enum class Outcome : uint8_t
+    {
+        Running = 0,
+        Win = 1,
+        TimeOut = 2
+    };
+
+    /** @brief SessionRecord::flags: the session was resumed from a checkpoint, earlier counters are missing */
+    constexpr uint8_t FLAG_RESUMED = 0x01;
+
+    /**
+     * @brief One session, stored as is in flash and in the export.
+     *
+     * Counters saturate instead of wrapping.
+     */
+    struct SessionRecord
+    {
+        uint16_t session;                       ///< Session number, counts up across resets
+        uint8_t outcome;                        ///< Outcome
+        uint8_t flags;                          ///< FLAG_* bits
+        uint16_t challengeSeconds[CHALLENGES];  ///< Time spent in each challenge
+        uint16_t runnerBestScore;               ///< Highest Runner score reached
+        uint8_t runnerDeaths;                   ///< Runner collisions
+        uint8_t escapeGateFailures;             ///< Failed gate attempts, each costs one life
+        uint8_t escapeRestarts;                 ///< Times all lives were lost
+        uint8_t memoryErrors[MEMORY_LEVELS];    ///< Wrong sequences per level
+        uint8_t archeryArrows[ARCHERY_ROUNDS];  ///< Arrows fired per round
+    };
+
+    static_assert(sizeof(SessionRecord) == 28, "SessionRecord layout is shared with tools/telemetry_decode.py");
+
+    /**
+     * @brief Mounts the flash log. Call once at boot.
+     */
+    void begin();
+
+    /**
+     * @brief Starts a new record.
+     *
+     * @param challenge First challenge of the session (1-based).
+     * @param resumed   The session continues from a checkpoint.
+     */
+    void beginSession(uint8_t challenge, bool resumed);
+
+    /**
+     * @brief Closes the time of the previous challenge and starts timing the next one.
+     */
+    void enterChallenge(uint8_t challenge);
+
+    /**
+     * @brief Finishes the record and writes it to flash.
+     */
+    void endSession(Outcome outcome);
+
+    void runnerDied(unsigned long score);
+    void memoryError(int level);
+    void escapeGateFailed();
+    void escapeOutOfLives();
+    void archeryArrow(int round);
+
+    /**
+     * @brief Prints the number of stored and pending records.
+     */
+    void printSummary(Print &out);
+
+    /**
+     * @brief Writes every stored record as one binary frame.
+     *
+     * Blocks until the frame is queued, up to about 0.7 s for a full log at
+     * 115200 baud; only call it between sessions.
+     */
+    void exportRecords(Print &out);
+
+    /**
+     * @brief Erases the stored records.
+     */
+    bool clear();
+}
+
+#endif // TELEMETRY_H
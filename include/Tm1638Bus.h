@@ -0,0 +1,147 @@
+#ifndef TM1638_BUS_H
+#define TM1638_BUS_H
+
+#include "FastPin.h"
+
+/**
+ * @brief Bit-banged TM1638 transfers on FastPin.
+ *
+ * Same wire protocol as TM1638plus (LSB first, data latched on the rising
+ * clock edge), without the digitalWrite()/digitalRead() lookups per bit. The
+ * chip allows at most 1 MHz, so each clock phase is stretched to about 500 ns
+ * at 72 MHz with a short spin.
+ *
+ * Covers the transfers the games issue every tick: key scans and single
+ * LED/digit writes. Initialisation and text rendering stay in TM1638plus.
+ *
+ * @tparam STB Strobe pin.
+ * @tparam CLK Clock pin.
+ * @tparam DIO Data pin.
+ */
+template <uint8_t STB, uint8_t CLK, uint8_t DIO>
+class Tm1638Bus
+{
+public:
+    static constexpr uint8_t CMD_WRITE_FIXED = 0x44;
+    static constexpr uint8_t CMD_READ_KEYS = 0x42;
+    static constexpr uint8_t CMD_ADDRESS = 0xC0;
+
+    /** @brief LED colour bits, the single-colour Whadda LEDs answer to GREEN */
+    static constexpr uint8_t LED_RED = 0x02;
+    static constexpr uint8_t LED_GREEN = 0x01;
+
+    /**
+     * @brief Writes one byte of display RAM.
+     *
+     * @param address Even addresses are digits, odd addresses LEDs.
+     * @param value   Segment or LED bits.
+     */
+    static void writeAt(uint8_t address, uint8_t value)
+    {
+        command(CMD_WRITE_FIXED);
+        Strobe::low();
+        send(CMD_ADDRESS | address);
+        send(value);
+        Strobe::high();
+    }
+
+    /**
+     * @brief Sets the segments of one digit (0-7).
+     */
+    static void digit(uint8_t position, uint8_t segments)
+    {
+        writeAt(position << 1, segments);
+    }
+
+    /**
+     * @brief Sets one LED (0-7), any non-zero colour bits turn it on.
+     */
+    static void led(uint8_t position, uint8_t colour)
+    {
+        writeAt((position << 1) + 1, colour);
+    }
+
+    /**
+     * @brief Sets all LEDs, as TM1638plus::setLEDs(): low byte red, high byte green.
+     */
+    static void leds(uint16_t greenred)
+    {
+        for (uint8_t position = 0; position < 8; position++)
+        {
+            uint8_t colour = 0;
+            if (greenred & (1U << position))
+                colour |= LED_RED;
+            if (greenred & (1U << (position + 8)))
+                colour |= LED_GREEN;
+            led(position, colour);
+        }
+    }
+
+    /**
+     * @brief Scans the 8 keys, bit n set while key n is held.
+     */
+    static uint8_t readKeys()
+    {
+        Strobe::low();
+        send(CMD_READ_KEYS);
+        Data::input();
+        delayMicroseconds(1); // Twait between the command and the first read
+
+        uint8_t keys = 0;
+        for (uint8_t i = 0; i < 4; i++)
+            keys |= receive() << i;
+
+        Data::output();
+        Strobe::high();
+        return keys;
+    }
+
+private:
+    typedef FastPin<STB> Strobe;
+    typedef FastPin<CLK> Clock;
+    typedef FastPin<DIO> Data;
+
+    static constexpr uint8_t HALF_PERIOD_SPINS = 10; // ~3.5 cycles each at 72 MHz
+
+    static inline void wait()
+    {
+        for (uint8_t i = 0; i < HALF_PERIOD_SPINS; i++)
+            __asm__ volatile("nop");
+    }
+
+    static void command(uint8_t value)
+    {
+        Strobe::low();
+        send(value);
+        Strobe::high();
+    }
+
+    static void send(uint8_t value)
+    {
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            Data::write(value & 1);
+            wait();
+            Clock::high();
+            wait();
+            Clock::low();
+            value >>= 1;
+        }
+    }
+
+    static uint8_t receive()
+    {
+        uint8_t value = 0;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            Clock::high();
+            wait();
+            value |= Data::read() << bit;
+            Clock::low();
+            wait();
+        }
+        return value;
+    }
+};
+
+#endif // TM1638_BUS_H
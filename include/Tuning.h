@@ -0,0 +1,71 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <Arduino.h>
+#include "Assets.h"
+
+/**
+ * @brief Difficulty parameters, loaded once at boot.
+ *
+ * Hot paths read the fields directly. Each value starts at its compile-time
+ * default (the game config namespaces) and can be overridden by the asset
+ * pack and then by the flash config store, so a room can be retuned without
+ * a firmware build.
+ */
+struct TuningConfig
+{
+    int32_t gameDurationMs;            ///< Total time to escape
+    int32_t runnerWinTimeMs;           ///< Runner game survival time
+    int32_t runnerSpeedFactorPermille; ///< Runner tick interval multiplier per speed level (RunnerSchedule.h)
+    int32_t memoryMaxLevel;            ///< Memory game levels to clear
+    int32_t escapeInRangeMs;           ///< Escape velocity hold time per gate
+    int32_t escapeTolerance;           ///< Escape velocity range slack
+    int32_t archeryToleranceRound1;    ///< Archery target size per round
+    int32_t archeryToleranceRound2;
+    int32_t archeryToleranceRound3;
+    int32_t runnerJumpBufferMs;        ///< Runner press kept this long to fire on landing
+    int32_t runnerCoyoteMs;            ///< Runner press this late still jumps over the obstacle
+    int32_t memoryAppendMode;          ///< Memory game keeps the sequence and appends a step per level
+    int32_t memoryTempoMinPercent;     ///< Memory playback fastest tempo, percent of nominal
+    int32_t memoryTempoMaxPercent;     ///< Memory playback slowest tempo
+    int32_t memoryChordWindowMs;       ///< Memory keys pressed this close together are an error, 0 allows them
+};
+
+extern TuningConfig tuning;
+
+namespace Tuning
+{
+    /**
+     * @brief Outcome of set().
+     */
+    enum class SetResult : uint8_t
+    {
+        Saved,      ///< Stored in flash and in effect
+        Invalid,    ///< Unknown key or value out of range, nothing changed
+        StoreFailed ///< The config store write failed, the old value stays in effect
+    };
+
+    /**
+     * @brief Fills in the tuning struct: defaults, then asset pack, then config store.
+     *
+     * Call once at boot after Assets::begin(). Out-of-range overrides are
+     * ignored and logged.
+     */
+    void load();
+
+    /**
+     * @brief Persists a parameter in the config store, then puts it in effect.
+     *
+     * @param key   Parameter to change.
+     * @param value New value.
+     * @return Whether the value was saved; it is only in effect if it was.
+     */
+    SetResult set(TuningKey key, int32_t value);
+
+    /**
+     * @brief Prints every parameter with its current value.
+     */
+    void print(Print &out);
+}
+
+#endif // TUNING_H
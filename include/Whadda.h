@@ -9,6 +9,7 @@
 #define BLINK_ALL 0xFF    // Bitmask to blink all LEDs
 
 #include "TM1638plus.h"
+#include "Assets.h"
 
 /**
  * @class Whadda
@@ -56,6 +57,13 @@ public:
      */
     void displayText(const char *text);
 
+    /**
+     * @brief Displays a UI string from the asset table.
+     *
+     * @param id String to display.
+     */
+    void displayText(StringId id);
+
     /**
      * @brief Displays an ASCII symbol at a specific position.
      *
@@ -144,11 +152,17 @@ public:
      */
     void showTemporaryMessage(const char *msg, int durationMs = MESSAGE_DELAY);
 
+    /**
+     * @brief shows a UI string from the asset table for a specified duration.
+     */
+    void showTemporaryMessage(StringId id, int durationMs = MESSAGE_DELAY);
+
     // Must be called repeatedly in loop() to process non-blocking events.
     void update();
 
 private:
     TM1638plus tm;
+    bool fastBus; ///< Wired as in pins.h, key scans and LED/digit writes use Tm1638Bus
 
     // Variables for non-blocking blinkLEDs
     bool blinking = false;
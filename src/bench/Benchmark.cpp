@@ -0,0 +1,382 @@
+#ifdef BENCHMARK
+
+#include "Benchmark.h"
+#include "Globals.h"
+#include "BusStats.h"
+#include "CycleCounter.h"
+#include "Stimulus.h"
+#include "Fmt.h"
+#include "FastPin.h"
+#include "KeyEvents.h"
+#include "Tm1638Bus.h"
+
+#include <stdio.h>
+
+#include "RunnerGame.h"
+#include "MemoryGame.h"
+#include "EscapeVelocity.h"
+#include "ArcheryChallenge.h"
+
+namespace
+{
+    /**
+     * @brief One step of a scripted scenario: hold the given inputs for a while.
+     */
+    struct Step
+    {
+        unsigned long durationMs;
+        Stimulus::Frame input;
+    };
+
+    /**
+     * @brief Cycle statistics over all ticks of a scenario.
+     */
+    struct TickStats
+    {
+        uint32_t ticks;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+
+        void add(uint32_t cycles)
+        {
+            ticks++;
+            totalCycles += cycles;
+            if (cycles < minCycles)
+                minCycles = cycles;
+            if (cycles > maxCycles)
+                maxCycles = cycles;
+        }
+    };
+
+    // Press jump to start, then keep jumping at a steady rhythm.
+    const Step RUNNER_SCENARIO[] = {
+        {100, {true, 0, 0}},   {600, {false, 0, 0}}, {100, {true, 0, 0}},  {600, {false, 0, 0}},
+        {100, {true, 0, 0}},   {600, {false, 0, 0}}, {100, {true, 0, 0}},  {600, {false, 0, 0}},
+        {100, {true, 0, 0}},   {600, {false, 0, 0}}, {100, {true, 0, 0}},  {3000, {false, 0, 0}},
+    };
+
+    // Watch the first sequence, then answer with key 1 a few times.
+    const Step MEMORY_SCENARIO[] = {
+        {6000, {false, 0x00, 0}}, {100, {false, 0x01, 0}}, {400, {false, 0x00, 0}},
+        {100, {false, 0x01, 0}},  {400, {false, 0x00, 0}}, {2000, {false, 0x00, 0}},
+    };
+
+    // Sweep the potentiometer across the whole range.
+    const Step ESCAPE_SCENARIO[] = {
+        {2500, {false, 0, 300}}, {2500, {false, 0, 500}},  {2500, {false, 0, 700}},
+        {2500, {false, 0, 900}}, {2500, {false, 0, 1023}},
+    };
+
+    // Aim at mid-range and fire an arrow every 1.5 s.
+    const Step ARCHERY_SCENARIO[] = {
+        {2500, {false, 0, 660}}, {100, {true, 0, 660}}, {1500, {false, 0, 660}},
+        {100, {true, 0, 660}},   {1500, {false, 0, 660}}, {100, {true, 0, 660}},
+        {1500, {false, 0, 660}},
+    };
+
+    void printField(const char *name, uint32_t value)
+    {
+        Serial.print(",\"");
+        Serial.print(name);
+        Serial.print("\":");
+        Serial.print(value);
+    }
+
+    void report(const char *game, const TickStats &stats)
+    {
+        const BusStats::Counters &bus = BusStats::counters;
+        uint32_t avg = stats.ticks ? (uint32_t)(stats.totalCycles / stats.ticks) : 0;
+
+        Serial.print("{\"bench\":\"tick\",\"game\":\"");
+        Serial.print(game);
+        Serial.print("\"");
+        printField("ticks", stats.ticks);
+        printField("cyc_min", stats.ticks ? stats.minCycles : 0);
+        printField("cyc_avg", avg);
+        printField("cyc_max", stats.maxCycles);
+        printField("us_max", CycleCounter::toMicros(stats.maxCycles));
+        printField("i2c_bytes", bus.i2cBytes);
+        printField("tm1638_tx", bus.tm1638Transactions);
+        printField("tones", bus.toneCalls);
+        printField("delay_ms", bus.delayMs);
+        Serial.println("}");
+    }
+
+    /**
+     * @brief Plays a scenario against a game and reports its per-tick cost.
+     *
+     * Only the game's run() is timed. The component updates that loop() performs
+     * around it are executed too, and their bus traffic is included.
+     */
+    void runScenario(const char *name, BaseGame &game, const Step *steps, size_t stepCount)
+    {
+        TickStats stats = {0, UINT32_MAX, 0, 0};
+        bool finished = false;
+
+        lcd.clear();
+        whadda.clearDisplay();
+        BusStats::reset();
+
+        for (size_t i = 0; i < stepCount && !finished; i++)
+        {
+            Stimulus::apply(steps[i].input);
+            unsigned long stepStart = millis();
+            while (!finished && millis() - stepStart < steps[i].durationMs)
+            {
+                rgbLed.update();
+                whadda.update();
+
+                uint32_t start = CycleCounter::now();
+                finished = game.run();
+                stats.add(CycleCounter::now() - start);
+            }
+        }
+
+        Stimulus::release();
+        report(name, stats);
+    }
+
+    constexpr uint16_t FORMAT_ITERATIONS = 1000;
+
+    // Inputs and output go through volatile so neither side can be folded away
+    volatile uint32_t formatInput = 0;
+    volatile char formatSink = 0;
+
+    void reportFormat(const char *name, uint32_t printfCycles, uint32_t fmtCycles)
+    {
+        Serial.print("{\"bench\":\"format\",\"case\":\"");
+        Serial.print(name);
+        Serial.print("\"");
+        printField("snprintf_cyc", printfCycles / FORMAT_ITERATIONS);
+        printField("fmt_cyc", fmtCycles / FORMAT_ITERATIONS);
+        Serial.println("}");
+    }
+
+    /**
+     * @brief Times the display formatting of the timer and the speed readout,
+     * snprintf against Fmt, averaged over FORMAT_ITERATIONS calls.
+     */
+    void runFormatBench()
+    {
+        char text[16];
+        uint32_t start;
+        uint32_t printfCycles = 0;
+        uint32_t fmtCycles = 0;
+
+        for (uint16_t i = 0; i < FORMAT_ITERATIONS; i++)
+        {
+            formatInput = 599 - i % 600;
+
+            start = CycleCounter::now();
+            snprintf(text, sizeof(text), "%02u:%02u", (unsigned)(formatInput / 60), (unsigned)(formatInput % 60));
+            printfCycles += CycleCounter::now() - start;
+            formatSink = text[4];
+
+            start = CycleCounter::now();
+            Fmt::writeMinutesSeconds(text, formatInput);
+            fmtCycles += CycleCounter::now() - start;
+            formatSink = text[4];
+        }
+        reportFormat("mm_ss", printfCycles, fmtCycles);
+
+        printfCycles = 0;
+        fmtCycles = 0;
+        for (uint16_t i = 0; i < FORMAT_ITERATIONS; i++)
+        {
+            formatInput = i % 1024;
+
+            start = CycleCounter::now();
+            snprintf(text, sizeof(text), "Spd %4d", (int)formatInput);
+            printfCycles += CycleCounter::now() - start;
+            formatSink = text[7];
+
+            start = CycleCounter::now();
+            Fmt::writeSigned<4>(text + 4, (int32_t)formatInput);
+            fmtCycles += CycleCounter::now() - start;
+            formatSink = text[7];
+        }
+        reportFormat("speed", printfCycles, fmtCycles);
+    }
+
+    /**
+     * @brief Times one Runner feedback flash, the old setColor()/delay()/off()
+     * against RGBLed::pulse(), and waits for the pulse to end by itself.
+     */
+    void runFeedbackBench()
+    {
+        uint32_t start = CycleCounter::now();
+        rgbLed.setColor(RunnerGameConfig::SCORE_LED_RED, RunnerGameConfig::SCORE_LED_GREEN, RunnerGameConfig::SCORE_LED_BLUE);
+        blockingDelay(RunnerGameConfig::LED_DURATION);
+        rgbLed.off();
+        uint32_t blockingCycles = CycleCounter::now() - start;
+
+        start = CycleCounter::now();
+        rgbLed.pulse(RunnerGameConfig::SCORE_LED_RED, RunnerGameConfig::SCORE_LED_GREEN, RunnerGameConfig::SCORE_LED_BLUE,
+                     RunnerGameConfig::LED_DURATION);
+        uint32_t pulseCycles = CycleCounter::now() - start;
+
+        unsigned long pulseStart = millis();
+        while (millis() - pulseStart <= RunnerGameConfig::LED_DURATION)
+            rgbLed.update();
+
+        Serial.print("{\"bench\":\"feedback\"");
+        printField("blocking_us", CycleCounter::toMicros(blockingCycles));
+        printField("pulse_us", CycleCounter::toMicros(pulseCycles));
+        Serial.println("}");
+    }
+
+    /**
+     * @brief One scripted TM1638 key scan.
+     */
+    struct KeyScan
+    {
+        uint32_t us;  ///< Scan time from the start of the burst
+        uint8_t keys; ///< Keys held
+    };
+
+    // Three staggered presses, a two-key chord and a bouncing key, then all released
+    const KeyScan KEY_BURST[] = {
+        {0, 0x00},     {100, 0x20},   {250, 0x24},   {400, 0xA4},   {40000, 0x00}, {80000, 0x42},
+        {120000, 0x00}, {160000, 0x08}, {160200, 0x00}, {160400, 0x08}, {160600, 0x00}, {160800, 0x08},
+        {200000, 0x00},
+    };
+
+    constexpr size_t KEY_BURST_SCANS = sizeof(KEY_BURST) / sizeof(KeyScan);
+
+    /**
+     * @brief Times the Memory Game's key queue: scan() per TM1638 scan and
+     * pop() per event, over a scripted burst.
+     *
+     * The event order and debouncing are covered by the host tests
+     * (test/test_key_events), this only measures the cost on the target.
+     */
+    void runKeyQueueBench()
+    {
+        KeyEventQueue<MemoryGameConfig::KEY_QUEUE_SIZE> queue(MemoryGameConfig::KEY_LOCKOUT_US);
+        uint32_t scanCycles = 0;
+        for (size_t i = 0; i < KEY_BURST_SCANS; i++)
+        {
+            uint32_t start = CycleCounter::now();
+            queue.scan(KEY_BURST[i].keys, MemoryGameConfig::KEY_LOCKOUT_US + KEY_BURST[i].us);
+            scanCycles += CycleCounter::now() - start;
+        }
+
+        uint32_t events = queue.size();
+        uint32_t popCycles = 0;
+        KeyEvent event;
+        for (uint32_t i = 0; i < events; i++)
+        {
+            uint32_t start = CycleCounter::now();
+            queue.pop(event);
+            popCycles += CycleCounter::now() - start;
+        }
+
+        Serial.print("{\"bench\":\"key_queue\"");
+        printField("events", events);
+        printField("scan_cyc", scanCycles / KEY_BURST_SCANS);
+        printField("pop_cyc", events ? popCycles / events : 0);
+        Serial.println("}");
+    }
+
+    constexpr uint16_t GPIO_ITERATIONS = 1000;
+    constexpr uint16_t KEY_SCAN_ITERATIONS = 50;
+
+    volatile int gpioSink = 0;
+
+    void reportGpio(const char *name, uint32_t arduinoCycles, uint32_t fastCycles, uint16_t iterations)
+    {
+        Serial.print("{\"bench\":\"gpio\",\"case\":\"");
+        Serial.print(name);
+        Serial.print("\"");
+        printField("arduino_cyc", arduinoCycles / iterations);
+        printField("fast_cyc", fastCycles / iterations);
+        Serial.println("}");
+    }
+
+    /**
+     * @brief Times pin reads, pin writes and a TM1638 key scan, Arduino API
+     * and TM1638plus against FastPin and Tm1638Bus.
+     */
+    void runGpioBench()
+    {
+        uint32_t start;
+        uint32_t arduinoCycles = 0;
+        uint32_t fastCycles = 0;
+
+        for (uint16_t i = 0; i < GPIO_ITERATIONS; i++)
+        {
+            start = CycleCounter::now();
+            gpioSink = digitalRead(BTN_PIN);
+            arduinoCycles += CycleCounter::now() - start;
+
+            start = CycleCounter::now();
+            gpioSink = FastPin<BTN_PIN>::read();
+            fastCycles += CycleCounter::now() - start;
+        }
+        reportGpio("read", arduinoCycles, fastCycles, GPIO_ITERATIONS);
+
+        // The strobe idles high, writing it high does not start a transfer
+        arduinoCycles = 0;
+        fastCycles = 0;
+        for (uint16_t i = 0; i < GPIO_ITERATIONS; i++)
+        {
+            start = CycleCounter::now();
+            digitalWrite(STB_PIN, HIGH);
+            arduinoCycles += CycleCounter::now() - start;
+
+            start = CycleCounter::now();
+            FastPin<STB_PIN>::high();
+            fastCycles += CycleCounter::now() - start;
+        }
+        reportGpio("write", arduinoCycles, fastCycles, GPIO_ITERATIONS);
+
+        TM1638plus reference(STB_PIN, CLK_PIN, DIO_PIN);
+        arduinoCycles = 0;
+        fastCycles = 0;
+        for (uint16_t i = 0; i < KEY_SCAN_ITERATIONS; i++)
+        {
+            start = CycleCounter::now();
+            gpioSink = reference.readButtons();
+            arduinoCycles += CycleCounter::now() - start;
+
+            start = CycleCounter::now();
+            gpioSink = Tm1638Bus<STB_PIN, CLK_PIN, DIO_PIN>::readKeys();
+            fastCycles += CycleCounter::now() - start;
+        }
+        reportGpio("key_scan", arduinoCycles, fastCycles, KEY_SCAN_ITERATIONS);
+    }
+}
+
+/**
+ * @brief Runs all benchmark scenarios and prints the results.
+ */
+void Benchmark::runAll()
+{
+    CycleCounter::begin();
+
+    Serial.print("{\"bench\":\"begin\"");
+    printField("core_hz", SystemCoreClock);
+    Serial.println("}");
+
+    static RunnerGame runnerGame;
+    runScenario("runner", runnerGame, RUNNER_SCENARIO, sizeof(RUNNER_SCENARIO) / sizeof(Step));
+
+    static MemoryGame memoryGame;
+    runScenario("memory", memoryGame, MEMORY_SCENARIO, sizeof(MEMORY_SCENARIO) / sizeof(Step));
+
+    static EscapeVelocity escapeVelocity;
+    runScenario("escape", escapeVelocity, ESCAPE_SCENARIO, sizeof(ESCAPE_SCENARIO) / sizeof(Step));
+
+    static ArcheryChallenge archeryChallenge;
+    runScenario("archery", archeryChallenge, ARCHERY_SCENARIO, sizeof(ARCHERY_SCENARIO) / sizeof(Step));
+
+    runFeedbackBench();
+    runKeyQueueBench();
+    runFormatBench();
+    runGpioBench();
+
+    Serial.println("{\"bench\":\"end\"}");
+}
+
+#endif // BENCHMARK
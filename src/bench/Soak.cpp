@@ -0,0 +1,245 @@
+#ifdef SOAK
+
+#include "Soak.h"
+#include "Globals.h"
+#include "Clock.h"
+#include "CostHistogram.h"
+#include "CycleCounter.h"
+#include "Stimulus.h"
+#include "Tuning.h"
+#include "RunnerGame.h"
+
+namespace
+{
+    using namespace RunnerGameConfig;
+
+    constexpr unsigned long TICK_MS = 2;        // Virtual time per loop iteration
+    constexpr unsigned long HOLD_MS = 250;      // How long the autoplayer holds a jump
+    constexpr unsigned long START_PRESS_MS = 100;
+    constexpr unsigned long SLACK_MS = 2 * TICK_MS; // Tolerance of the state timing checks
+    constexpr uint8_t MAX_PRINTED_ANOMALIES = 20;
+    constexpr uint8_t LEVELS = RunnerSchedule::MAX_LEVEL + 1;
+
+    /**
+     * @brief Jumps when a ground obstacle is one cell away and lands early
+     * when a bird comes close.
+     *
+     * The jump starts on the next step, before the obstacle moves into
+     * column 0, so column 1 is the last moment to press.
+     */
+    struct Autoplayer
+    {
+        unsigned long holdUntil;
+
+        bool button(const RunnerView &view, unsigned long now)
+        {
+            switch (view.state)
+            {
+            case RunnerGameState::Idle:
+                return (now / START_PRESS_MS) % 2 == 0; // Tap to start
+            case RunnerGameState::Playing:
+                break;
+            default:
+                return false;
+            }
+
+            bool groundNext = (view.laneMask[GROUND_ROW] & 0x2) != 0;
+            bool birdNear = (view.laneMask[JUMP_ROW] & 0x7) != 0;
+            if (!view.isJumping && groundNext && now >= holdUntil)
+                holdUntil = now + HOLD_MS;
+            return now < holdUntil && !birdNear;
+        }
+    };
+
+    struct Report
+    {
+        uint32_t games;
+        uint32_t wins;
+        uint32_t reached[LEVELS]; // Games that got to each speed level
+        uint32_t died[LEVELS];    // Games that ended there
+        uint32_t anomalies;
+        CostHistogram ticks;
+    };
+
+    Report report;
+
+    void printField(const char *name, uint32_t value)
+    {
+        Serial.print(",\"");
+        Serial.print(name);
+        Serial.print("\":");
+        Serial.print(value);
+    }
+
+    void anomaly(const char *kind, unsigned long at)
+    {
+        if (report.anomalies++ >= MAX_PRINTED_ANOMALIES)
+            return;
+        Serial.print("{\"soak\":\"anomaly\",\"kind\":\"");
+        Serial.print(kind);
+        Serial.print("\"");
+        printField("game", report.games);
+        printField("at_ms", at);
+        Serial.println("}");
+    }
+
+    /**
+     * @brief Checks the world invariants and the state machine timing after one run().
+     */
+    class Monitor
+    {
+    public:
+        void check(const RunnerView &view, unsigned long now)
+        {
+            if (view.state != lastState)
+            {
+                transition(view, now);
+                lastState = view.state;
+                stateSince = now;
+            }
+
+            if (view.state == RunnerGameState::Playing)
+            {
+                if (view.score < lastScore)
+                    anomaly("score_drop", now);
+                lastScore = view.score;
+
+                uint8_t occupied = __builtin_popcount(view.laneMask[JUMP_ROW]) + __builtin_popcount(view.laneMask[GROUND_ROW]);
+                if (view.obstacleCount > MAX_OBSTACLES || occupied != view.obstacleCount)
+                    anomaly("obstacle_mismatch", now);
+
+                if (view.speedLevel > maxLevel)
+                    maxLevel = view.speedLevel;
+                if (!overdue && now - stateSince > (unsigned long)tuning.runnerWinTimeMs + SLACK_MS)
+                {
+                    overdue = true;
+                    anomaly("missed_win", now);
+                }
+            }
+            else if (view.state == RunnerGameState::Winning && !overdue &&
+                     now - stateSince > WIN_STATE_DURATION + SLACK_MS)
+            {
+                overdue = true;
+                anomaly("stuck_winning", now);
+            }
+        }
+
+    private:
+        RunnerGameState lastState = RunnerGameState::Idle;
+        unsigned long stateSince = 0;
+        unsigned long lastScore = 0;
+        uint8_t maxLevel = 0;
+        bool overdue = false;
+
+        void transition(const RunnerView &view, unsigned long now)
+        {
+            overdue = false;
+            if (lastState == RunnerGameState::Playing)
+                endGame(view.state == RunnerGameState::Winning);
+
+            if (view.state == RunnerGameState::Playing)
+            {
+                if (lastState == RunnerGameState::GameOver && now - stateSince < RESTART_DELAY)
+                    anomaly("early_restart", now);
+                if (lastState == RunnerGameState::Winning)
+                    anomaly("win_to_playing", now);
+                lastScore = 0;
+                maxLevel = 0;
+            }
+        }
+
+        void endGame(bool won)
+        {
+            report.games++;
+            for (uint8_t level = 0; level <= maxLevel; level++)
+                report.reached[level]++;
+            if (won)
+                report.wins++;
+            else
+                report.died[maxLevel]++;
+        }
+    };
+
+    void printReport()
+    {
+        for (uint8_t level = 0; level < LEVELS; level++)
+        {
+            if (report.reached[level] == 0)
+                continue;
+            Serial.print("{\"soak\":\"tier\"");
+            printField("level", level);
+            printField("interval_ms", RunnerSchedule::levelInterval(level, INITIAL_GAME_INTERVAL, MIN_GAME_INTERVAL,
+                                                                    tuning.runnerSpeedFactorPermille));
+            printField("reached", report.reached[level]);
+            printField("died", report.died[level]);
+            printField("survival_permille", 1000 - report.died[level] * 1000 / report.reached[level]);
+            Serial.println("}");
+        }
+
+        Serial.print("{\"soak\":\"tick\"");
+        printField("ticks", report.ticks.total);
+        printField("p50_us", report.ticks.percentile(500));
+        printField("p90_us", report.ticks.percentile(900));
+        printField("p99_us", report.ticks.percentile(990));
+        printField("p999_us", report.ticks.percentile(999));
+        printField("max_us", report.ticks.maxUs);
+        Serial.println("}");
+
+        Serial.print("{\"soak\":\"summary\"");
+        printField("games", report.games);
+        printField("wins", report.wins);
+        printField("anomalies", report.anomalies);
+        Serial.println("}");
+    }
+}
+
+/**
+ * @brief Plays SOAK_GAMES runs and prints the report.
+ *
+ * Every iteration advances the virtual clock by TICK_MS, so a run takes as
+ * much game time as on the real loop but only as much wall time as the code
+ * and the LCD need. The seed is fixed, so two soaks of the same firmware
+ * play the same games.
+ */
+void Soak::run()
+{
+    CycleCounter::begin();
+    Clock::useVirtual();
+    randomSeed(SOAK_GAMES);
+
+    static RunnerGame game;
+    game.init();
+
+    Autoplayer player = {0};
+    Monitor monitor;
+    RunnerView view;
+    game.observe(view);
+
+    Serial.print("{\"soak\":\"begin\"");
+    printField("games", SOAK_GAMES);
+    printField("tick_ms", TICK_MS);
+    Serial.println("}");
+
+    while (report.games < SOAK_GAMES)
+    {
+        unsigned long now = Clock::now();
+        Stimulus::apply(Stimulus::Frame{player.button(view, now), 0, 0});
+        rgbLed.update();
+
+        uint32_t start = CycleCounter::now();
+        game.run();
+        report.ticks.add(CycleCounter::toMicros(CycleCounter::now() - start));
+
+        game.observe(view);
+        monitor.check(view, now);
+        Clock::advance(TICK_MS);
+    }
+
+    Stimulus::release();
+    Clock::useReal();
+    game.reset();
+    printReport();
+    Serial.println("{\"soak\":\"end\"}");
+}
+
+#endif // SOAK
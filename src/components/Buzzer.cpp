@@ -1,5 +1,6 @@
 #include "Buzzer.h"
 #include <Arduino.h>
+#include "BusStats.h"
 
 /**
  * @brief Constructs a Buzzer object.
@@ -10,10 +11,15 @@ Buzzer::Buzzer(int pin) : _pin(pin) {}
 
 /**
  * @brief Initializes the buzzer by setting the pin mode.
+ *
+ * Also plays an inaudible 1 ms tone so the core allocates its tone timer
+ * now rather than on the first note of a game.
  */
 void Buzzer::begin()
 {
+    const unsigned int warmupFrequency = 20000; // Above hearing range
     pinMode(_pin, OUTPUT);
+    tone(_pin, warmupFrequency, 1);
 }
 
 /**
@@ -25,6 +31,7 @@ void Buzzer::begin()
  */
 void Buzzer::playTone(unsigned int frequency, unsigned long duration)
 {
+    BUS_STATS_ADD(toneCalls, 1);
     if (duration == 0)
     {
         tone(_pin, frequency);
@@ -44,140 +51,26 @@ void Buzzer::stop()
 }
 
 /**
- * @brief Plays a winning melody.
+ * @brief Plays a melody from the asset table.
  *
- * @param repeat Number of times to repeat the melody.
- */
-void Buzzer::playWinMelody(unsigned int repeat)
-{
-    for (unsigned int i = 0; i < repeat; i++)
-    {
-        playTone(523, 150); // C5
-        delay(160);
-
-        playTone(659, 150); // E5
-        delay(160);
-
-        playTone(783, 200); // G5
-        delay(210);
-
-        playTone(1046, 300); // C6 (High)
-        delay(310);
-
-        playTone(880, 250); // A5
-        delay(260);
-
-        playTone(987, 400); // B5
-        delay(450);
-
-        stop();
-        delay(200); // short pause between repetitions
-    }
-}
-
-/**
- * @brief Plays a losing melody.
+ * The notes are read in place from flash.
  *
+ * @param id     Melody to play.
  * @param repeat Number of times to repeat the melody.
  */
-void Buzzer::playLoseMelody(unsigned int repeat)
+void Buzzer::playMelody(MelodyId id, unsigned int repeat)
 {
-    for (unsigned int i = 0; i < repeat; i++)
-    {
-        playTone(440, 250); // A4
-        delay(260);
-
-        playTone(415, 200); // G#4
-        delay(210);
-
-        playTone(392, 250); // G4
-        delay(260);
-
-        playTone(349, 300); // F4
-        delay(310);
+    const Melody melody = Assets::melody(id);
 
-        playTone(261, 450); // C4 (Low)
-        delay(460);
-
-        stop();
-        delay(200); // short pause between repetitions
-    }
-}
-
-void Buzzer::playRoundStartMelody(unsigned int repeat)
-{
     for (unsigned int i = 0; i < repeat; i++)
     {
-        playTone(440, 200); // A4
-        delay(210);
-
-        playTone(523, 200); // C5
-        delay(210);
-
-        playTone(659, 200); // E5
-        delay(210);
-
-        playTone(784, 200); // G5
-        delay(210);
-
-        playTone(880, 200); // A5
-        delay(210);
+        for (uint8_t n = 0; n < melody.length; n++)
+        {
+            playTone(melody.notes[n].frequency, melody.notes[n].duration);
+            blockingDelay(melody.notes[n].gap);
+        }
 
         stop();
-        delay(200); // short pause between repetitions
+        blockingDelay(melody.pauseMs); // short pause between repetitions
     }
 }
-
-// *** CREDITS TO CHATGPT FOR THIS MELODY
-// *** IMPERIAL MARCH MELODY
-/**
- * @brief Plays the Imperial March melody.
- *
- * @param repeat Number of times to repeat the melody.
- */
-void Buzzer::playImperialMarch(unsigned int repeat)
-{
-    for (unsigned int i = 0; i < repeat; i++)
-    {
-        playTone(440, 400); // A4
-        delay(450);
-        playTone(440, 400); // A4
-        delay(450);
-        playTone(440, 400); // A4
-        delay(450);
-        playTone(349, 300); // F4
-        delay(350);
-        playTone(523, 150); // C5
-        delay(200);
-        playTone(440, 400); // A4
-        delay(450);
-        playTone(349, 300); // F4
-        delay(350);
-        playTone(523, 150); // C5
-        delay(200);
-        playTone(440, 800); // A4
-        delay(850);
-
-        playTone(659, 400); // E5
-        delay(450);
-        playTone(659, 400); // E5
-        delay(450);
-        playTone(659, 400); // E5
-        delay(450);
-        playTone(698, 300); // F5
-        delay(350);
-        playTone(523, 150); // C5
-        delay(200);
-        playTone(415, 400); // G#4
-        delay(450);
-        playTone(349, 300); // F4
-        delay(350);
-        playTone(523, 150); // C5
-        delay(200);
-        playTone(440, 800); // A4
-        delay(850);
-
-        stop();
-        delay(400); // pause between repetitions
-    }
-}
\ No newline at end of file
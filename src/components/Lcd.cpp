@@ -0,0 +1,96 @@
+#include "Lcd.h"
+#include "BusStats.h"
+
+/**
+ * @brief Constructs an Lcd object.
+ *
+ * @param address I2C address of the PCF8574 backpack.
+ * @param cols    Number of columns.
+ * @param rows    Number of rows.
+ */
+Lcd::Lcd(uint8_t address, uint8_t cols, uint8_t rows)
+    : LiquidCrystal_I2C(address, cols, rows), clearCount(0)
+{
+}
+
+/**
+ * @brief Clears the display and moves the cursor home.
+ *
+ * The controller needs about 2 ms for this, the library waits it out.
+ */
+void Lcd::clear()
+{
+    BUS_STATS_ADD(i2cBytes, BusStats::LCD_I2C_BYTES_PER_TRANSFER);
+    BUS_STATS_ADD(delayMs, BusStats::LCD_SLOW_COMMAND_MS);
+    clearCount++;
+    LiquidCrystal_I2C::clear();
+}
+
+/**
+ * @brief Moves the cursor to the top-left position.
+ */
+void Lcd::home()
+{
+    BUS_STATS_ADD(i2cBytes, BusStats::LCD_I2C_BYTES_PER_TRANSFER);
+    BUS_STATS_ADD(delayMs, BusStats::LCD_SLOW_COMMAND_MS);
+    LiquidCrystal_I2C::home();
+}
+
+/**
+ * @brief Moves the cursor to the given position.
+ *
+ * @param col Column (0-based).
+ * @param row Row (0-based).
+ */
+void Lcd::setCursor(uint8_t col, uint8_t row)
+{
+    BUS_STATS_ADD(i2cBytes, BusStats::LCD_I2C_BYTES_PER_TRANSFER);
+    LiquidCrystal_I2C::setCursor(col, row);
+}
+
+/**
+ * @brief Uploads a custom character to CGRAM.
+ *
+ * The 8 bitmap rows go through write(), only the address command is counted here.
+ *
+ * @param location CGRAM slot (0-7).
+ * @param charmap  8-byte bitmap.
+ */
+void Lcd::createChar(uint8_t location, uint8_t charmap[])
+{
+    BUS_STATS_ADD(i2cBytes, BusStats::LCD_I2C_BYTES_PER_TRANSFER);
+    LiquidCrystal_I2C::createChar(location, charmap);
+}
+
+/**
+ * @brief Uploads a custom character from the asset table to CGRAM.
+ *
+ * The library only reads the bitmap, so it is passed straight from flash.
+ *
+ * @param location CGRAM slot (0-7).
+ * @param glyph    Bitmap to upload.
+ */
+void Lcd::createChar(uint8_t location, GlyphId glyph)
+{
+    createChar(location, const_cast<uint8_t *>(Assets::glyph(glyph)));
+}
+
+/**
+ * @brief Prints a UI string from the asset table at the cursor position.
+ *
+ * @param id String to print.
+ * @return Number of characters written.
+ */
+size_t Lcd::print(StringId id)
+{
+    return LiquidCrystal_I2C::print(Assets::string(id));
+}
+
+/**
+ * @brief Writes one character at the cursor position.
+ */
+size_t Lcd::write(uint8_t value)
+{
+    BUS_STATS_ADD(i2cBytes, BusStats::LCD_I2C_BYTES_PER_TRANSFER);
+    return LiquidCrystal_I2C::write(value);
+}
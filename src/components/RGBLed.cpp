@@ -1,4 +1,6 @@
 #include "RGBLed.h"
+#include "BusStats.h"
+#include "Profiler.h"
 
 /**
  * @brief Constructs an RGBLed object.
@@ -15,7 +17,17 @@ RGBLed::RGBLed(int redPin, int greenPin, int bluePin)
       _bluePin(bluePin),
       _currentRed(0),
       _currentGreen(0),
-      _currentBlue(0) {}
+      _currentBlue(0),
+      _isPulsing(false),
+      _pulseStart(0),
+      _pulseDuration(0),
+      _isBlinking(false),
+      _blinkCount(0),
+      _blinkState(false),
+      _lastBlinkTime(0),
+      _blinkRed(0),
+      _blinkGreen(0),
+      _blinkBlue(0) {}
 
 /**
  * @brief Initializes the pins and turns the LED off.
@@ -31,11 +43,23 @@ void RGBLed::begin()
 /**
  * @brief Sets the RGB LED to the specified color values.
  *
+ * Cancels a running pulse or blink sequence.
+ *
  * @param redValue   The intensity of the red channel (0-255).
  * @param greenValue The intensity of the green channel (0-255).
  * @param blueValue  The intensity of the blue channel (0-255).
  */
 void RGBLed::setColor(int redValue, int greenValue, int blueValue)
+{
+    _isPulsing = false;
+    _isBlinking = false;
+    writeColor(redValue, greenValue, blueValue);
+}
+
+/**
+ * @brief Drives the pins without touching the running effect.
+ */
+void RGBLed::writeColor(int redValue, int greenValue, int blueValue)
 {
     analogWrite(_redPin, redValue);
     analogWrite(_greenPin, greenValue);
@@ -66,6 +90,22 @@ void RGBLed::off()
     setColor(0, 0, 0);
 }
 
+/**
+ * @brief Lights the LED for a while, update() turns it off again.
+ *
+ * @param redValue   The intensity of the red channel (0-255).
+ * @param greenValue The intensity of the green channel (0-255).
+ * @param blueValue  The intensity of the blue channel (0-255).
+ * @param durationMs How long the LED stays on.
+ */
+void RGBLed::pulse(int redValue, int greenValue, int blueValue, unsigned long durationMs)
+{
+    setColor(redValue, greenValue, blueValue);
+    _isPulsing = true;
+    _pulseStart = millis();
+    _pulseDuration = durationMs;
+}
+
 
 /**
  * @brief Blinks the current color a specified number of times.
@@ -81,9 +121,9 @@ void RGBLed::blinkCurrentColor(int count)
     for (int i = 0; i < count; i++)
     {
         off();
-        delay(BLINK_DELAY);
+        blockingDelay(BLINK_DELAY);
         setColor(savedRed, savedGreen, savedBlue);
-        delay(BLINK_DELAY);
+        blockingDelay(BLINK_DELAY);
     }
 }
 
@@ -100,9 +140,9 @@ void RGBLed::blinkColor(int redValue, int greenValue, int blueValue, int count)
     for (int i = 0; i < count; i++)
     {
         off();
-        delay(BLINK_DELAY);
+        blockingDelay(BLINK_DELAY);
         setColor(redValue, greenValue, blueValue);
-        delay(BLINK_DELAY);
+        blockingDelay(BLINK_DELAY);
     }
 }
 
@@ -116,6 +156,7 @@ void RGBLed::startBlinkCurrent(int count)
 // 'count' indicates the number of full blink cycles.
 void RGBLed::startBlinkColor(int redValue, int greenValue, int blueValue, int count)
 {
+    setColor(redValue, greenValue, blueValue);
     _isBlinking = true;
     // For count blink cycles, we need count*2 transitions (LED off and on)
     _blinkCount = count * 2;
@@ -124,12 +165,18 @@ void RGBLed::startBlinkColor(int redValue, int greenValue, int blueValue, int co
     _blinkRed = redValue;
     _blinkGreen = greenValue;
     _blinkBlue = blueValue;
-    setColor(redValue, greenValue, blueValue);
 }
 
 // Call this method in loop() to update the blinking state.
 void RGBLed::update()
 {
+    PROFILE_ZONE(ProfileZone::RgbUpdate);
+
+    if (_isPulsing && millis() - _pulseStart >= _pulseDuration)
+    {
+        off();
+    }
+
     if (_isBlinking)
     {
         unsigned long currentMillis = millis();
@@ -138,11 +185,11 @@ void RGBLed::update()
             _lastBlinkTime = currentMillis;
             if (_blinkState)
             {
-                off();
+                writeColor(0, 0, 0);
             }
             else
             {
-                setColor(_blinkRed, _blinkGreen, _blinkBlue);
+                writeColor(_blinkRed, _blinkGreen, _blinkBlue);
             }
             _blinkState = !_blinkState;
             _blinkCount--;
@@ -150,7 +197,7 @@ void RGBLed::update()
             {
                 _isBlinking = false;
                 // Optionally, leave the LED on after finishing:
-                setColor(_blinkRed, _blinkGreen, _blinkBlue);
+                writeColor(_blinkRed, _blinkGreen, _blinkBlue);
             }
         }
     }
@@ -1,4 +1,28 @@
 #include "Whadda.h"
+#include "BusStats.h"
+#include "Stimulus.h"
+#include "Profiler.h"
+#include "Fmt.h"
+#include "Pins.h"
+#include "Tm1638Bus.h"
+
+namespace
+{
+    // Strobe-framed transfers issued by TM1638plus per call, used for the bus statistics.
+    constexpr uint32_t TM_FRAMES_SINGLE_WRITE = 2; // fixed-address command + address/data frame
+    constexpr uint32_t TM_FRAMES_READ_KEYS = 1;
+    constexpr uint32_t TM_FRAMES_BEGIN = 4;
+    constexpr uint8_t TM_DIGITS = 8;
+
+    // Register-level transport for the module wired as in pins.h
+    typedef Tm1638Bus<STB_PIN, CLK_PIN, DIO_PIN> FastBus;
+
+    uint32_t textFrames(const char *text)
+    {
+        size_t len = strlen(text);
+        return TM_FRAMES_SINGLE_WRITE * (len < TM_DIGITS ? len : TM_DIGITS);
+    }
+}
 
 /**
  * @brief Constructs a new Whadda object and initializes the TM1638plus instance.
@@ -9,7 +33,8 @@
  * @param highfreq Optional flag to indicate high frequency operation.
  */
 Whadda::Whadda(uint8_t strobe, uint8_t clock, uint8_t data, bool highfreq)
-    : tm(strobe, clock, data, highfreq)
+    : tm(strobe, clock, data, highfreq),
+      fastBus(strobe == STB_PIN && clock == CLK_PIN && data == DIO_PIN)
 {
 }
 
@@ -18,6 +43,7 @@ Whadda::Whadda(uint8_t strobe, uint8_t clock, uint8_t data, bool highfreq)
  */
 void Whadda::displayBegin()
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_BEGIN);
     tm.displayBegin();
 }
 
@@ -29,7 +55,11 @@ void Whadda::displayBegin()
  */
 void Whadda::setLED(uint8_t position, uint8_t value)
 {
-    tm.setLED(position, value);
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_SINGLE_WRITE);
+    if (fastBus)
+        FastBus::led(position, value);
+    else
+        tm.setLED(position, value);
 }
 
 /**
@@ -39,7 +69,11 @@ void Whadda::setLED(uint8_t position, uint8_t value)
  */
 void Whadda::setLEDs(uint16_t greenred)
 {
-    tm.setLEDs(greenred);
+    BUS_STATS_ADD(tm1638Transactions, TM_DIGITS * TM_FRAMES_SINGLE_WRITE);
+    if (fastBus)
+        FastBus::leds(greenred);
+    else
+        tm.setLEDs(greenred);
 }
 
 /**
@@ -49,9 +83,20 @@ void Whadda::setLEDs(uint16_t greenred)
  */
 void Whadda::displayText(const char *text)
 {
+    BUS_STATS_ADD(tm1638Transactions, textFrames(text));
     tm.displayText(text);
 }
 
+/**
+ * @brief Displays a UI string from the asset table.
+ *
+ * @param id String to display.
+ */
+void Whadda::displayText(StringId id)
+{
+    displayText(Assets::string(id));
+}
+
 /**
  * @brief Displays an ASCII value on the display at the given position.
  *
@@ -60,6 +105,7 @@ void Whadda::displayText(const char *text)
  */
 void Whadda::displayASCII(uint8_t position, uint8_t ascii)
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_SINGLE_WRITE);
     tm.displayASCII(position, ascii);
 }
 
@@ -71,6 +117,7 @@ void Whadda::displayASCII(uint8_t position, uint8_t ascii)
  */
 void Whadda::displayASCIIwDot(uint8_t position, uint8_t ascii)
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_SINGLE_WRITE);
     tm.displayASCIIwDot(position, ascii);
 }
 
@@ -82,6 +129,7 @@ void Whadda::displayASCIIwDot(uint8_t position, uint8_t ascii)
  */
 void Whadda::displayHex(uint8_t position, uint8_t hex)
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_SINGLE_WRITE);
     tm.displayHex(position, hex);
 }
 
@@ -93,7 +141,11 @@ void Whadda::displayHex(uint8_t position, uint8_t hex)
  */
 void Whadda::display7Seg(uint8_t position, uint8_t value)
 {
-    tm.display7Seg(position, value);
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_SINGLE_WRITE);
+    if (fastBus)
+        FastBus::digit(position, value);
+    else
+        tm.display7Seg(position, value);
 }
 
 /**
@@ -105,7 +157,22 @@ void Whadda::display7Seg(uint8_t position, uint8_t value)
  */
 void Whadda::displayIntNum(unsigned long number, boolean leadingZeros, AlignTextType_e alignment)
 {
-    tm.displayIntNum(number, leadingZeros, alignment);
+    // Formatted here rather than in TM1638plus, which goes through snprintf
+    char text[TM_DIGITS + 1];
+    Fmt::writeUnsigned<TM_DIGITS>(text, number, leadingZeros ? '0' : ' ');
+    text[TM_DIGITS] = '\0';
+
+    if (!leadingZeros && alignment == TMAlignTextLeft)
+    {
+        uint8_t digits = Fmt::digitCount(number);
+        if (digits < TM_DIGITS)
+        {
+            memmove(text, text + TM_DIGITS - digits, digits);
+            memset(text + digits, ' ', TM_DIGITS - digits);
+        }
+    }
+
+    displayText(text);
 }
 
 /**
@@ -118,6 +185,7 @@ void Whadda::displayIntNum(unsigned long number, boolean leadingZeros, AlignText
  */
 void Whadda::DisplayDecNumNibble(uint16_t numberUpper, uint16_t numberLower, boolean leadingZeros, AlignTextType_e alignment)
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_DIGITS * TM_FRAMES_SINGLE_WRITE);
     tm.DisplayDecNumNibble(numberUpper, numberLower, leadingZeros, alignment);
 }
 
@@ -128,7 +196,8 @@ void Whadda::DisplayDecNumNibble(uint16_t numberUpper, uint16_t numberLower, boo
  */
 uint8_t Whadda::readButtons()
 {
-    return tm.readButtons();
+    BUS_STATS_ADD(tm1638Transactions, TM_FRAMES_READ_KEYS);
+    return Stimulus::keys(fastBus ? FastBus::readKeys() : tm.readButtons());
 }
 
 /**
@@ -143,12 +212,13 @@ uint8_t Whadda::readButtons()
  */
 uint8_t Whadda::readButtonsWithDebounce(int debounceDelayMs)
 {
-    unsigned long t0 = millis();
-    uint8_t last = tm.readButtons();
+    unsigned long start = millis();
+    unsigned long t0 = start;
+    uint8_t last = readButtons();
 
     while (millis() - t0 < debounceDelayMs)
     {
-        uint8_t current = tm.readButtons();
+        uint8_t current = readButtons();
         if (current != last)
         {
             t0 = millis();
@@ -156,6 +226,7 @@ uint8_t Whadda::readButtonsWithDebounce(int debounceDelayMs)
         }
     }
 
+    BUS_STATS_ADD(delayMs, millis() - start);
     return last;
 }
 /**
@@ -165,15 +236,23 @@ uint8_t Whadda::readButtonsWithDebounce(int debounceDelayMs)
  */
 void Whadda::clearDisplay()
 {
+    BUS_STATS_ADD(tm1638Transactions, TM_DIGITS * TM_FRAMES_SINGLE_WRITE);
     for (int i = 0; i <= 7; i++)
     {
-        tm.display7Seg(i, 0x00);
+        if (fastBus)
+            FastBus::digit(i, 0x00);
+        else
+            tm.display7Seg(i, 0x00);
     }
 }
 
 void Whadda::clearLEDs()
 {
-    tm.setLEDs(0x0000);
+    BUS_STATS_ADD(tm1638Transactions, TM_DIGITS * TM_FRAMES_SINGLE_WRITE);
+    if (fastBus)
+        FastBus::leds(0x0000);
+    else
+        tm.setLEDs(0x0000);
 }
 
 /**
@@ -216,6 +295,17 @@ void Whadda::showTemporaryMessage(const char *msg, int durationMs)
     temporaryMessage = msg; // Assumes msg is stored in a valid location
 }
 
+/**
+ * @brief Initiates a non-blocking temporary message display with a UI string.
+ *
+ * @param id String to display.
+ * @param durationMs Duration (in ms) to display the message.
+ */
+void Whadda::showTemporaryMessage(StringId id, int durationMs)
+{
+    showTemporaryMessage(Assets::string(id), durationMs);
+}
+
 /**
  * @brief Processes non-blocking events.
  *
@@ -224,6 +314,8 @@ void Whadda::showTemporaryMessage(const char *msg, int durationMs)
  */
 void Whadda::update()
 {
+    PROFILE_ZONE(ProfileZone::WhaddaUpdate);
+
     unsigned long currentMillis = millis();
 
     // Process blinking LEDs
@@ -233,7 +325,7 @@ void Whadda::update()
         {
             lastBlinkTime = currentMillis;
             ledState = !ledState;
-            tm.setLEDs(ledState ? blinkLedNum : 0x0000);
+            setLEDs(ledState ? blinkLedNum : 0x0000);
 
             // Count a blink cycle when turning the LED on
             if (ledState)
@@ -242,7 +334,7 @@ void Whadda::update()
                 if (blinkLedCount >= blinkCountMax)
                 {
                     blinking = false;
-                    tm.setLEDs(0x0000); // Ensure LEDs are turned off
+                    setLEDs(0x0000); // Ensure LEDs are turned off
                 }
             }
         }
@@ -1,5 +1,11 @@
 #include "Globals.h"
+#include "Tuning.h"
+#include "Telemetry.h"
 #include "ArcheryChallenge.h"
+#include "Profiler.h"
+#include "Stimulus.h"
+#include "Fmt.h"
+#include "Log.h"
 
 /**
  * @brief Constructor for ArcheryChallenge
@@ -10,6 +16,7 @@
 ArcheryChallenge::ArcheryChallenge()
     : state(ArcheryState::Init),
       currentRound(1),
+      resumeRound(1),
       roundResult(false),
       stateStart(0),
       roundState(RoundAttemptState::Init),
@@ -26,6 +33,30 @@ ArcheryChallenge::ArcheryChallenge()
 {
 }
 
+/**
+ * @brief Makes init() continue at a checkpointed round
+ *
+ * @param progress Round from getProgress(), ignored if out of range
+ */
+void ArcheryChallenge::resumeFrom(uint32_t progress)
+{
+    if (progress >= 1 && progress <= (uint32_t)ArcheryConfig::TOTAL_ROUNDS)
+        resumeRound = progress;
+}
+
+/**
+ * @brief Returns the game to its initial state
+ *
+ * The next run() goes through init() and the intro again.
+ */
+void ArcheryChallenge::reset()
+{
+    state = ArcheryState::Init;
+    resumeRound = 1;
+    whadda.clearDisplay();
+    rgbLed.off();
+}
+
 /**
  * @brief Initializes the game
  * 
@@ -35,9 +66,11 @@ ArcheryChallenge::ArcheryChallenge()
 void ArcheryChallenge::init()
 {
     // Play a short melody to signal the challenge start
-    buzzer.playRoundStartMelody();
-    // Initialize game variables
+    buzzer.playMelody(MelodyId::RoundStart);
+    // Initialize game variables, a resumed session keeps its round
     resetGameState();
+    currentRound = resumeRound;
+    resumeRound = 1;
     // Reset displays
     whadda.clearDisplay();
     rgbLed.off();
@@ -55,7 +88,9 @@ void ArcheryChallenge::init()
  */
 bool ArcheryChallenge::run()
 {
-    unsigned long now = millis();
+    PROFILE_ZONE(ProfileZone::ArcheryRun);
+
+    unsigned long now = Clock::now();
 
     switch (state)
     {
@@ -67,7 +102,7 @@ bool ArcheryChallenge::run()
 
     case ArcheryState::Intro:
         // Display introductory message for the Archery Challenge
-        displayLcdMessage("Archery Challenge", "Ready your bow!", true);
+        displayLcdMessage(StringId::ArcheryTitle, StringId::ReadyBow, true);
         stateStart = now;
         state = ArcheryState::WaitIntro;
         break;
@@ -111,7 +146,7 @@ bool ArcheryChallenge::run()
         else
         {
             // The player failed to hit the target in this round (out of arrows)
-            Serial.println("Round " + String(currentRound) + " failed. Restarting challenge.");
+            LOG_INFO(ARCHERY, ArcheryRoundFailed, currentRound);
             // Sound a failure tone
             playFailSound();
             stateStart = now;
@@ -128,6 +163,7 @@ bool ArcheryChallenge::run()
             currentRound++;
             showTimer = true;
             roundState = RoundAttemptState::Init;
+            requestCheckpoint();
 
             // If we just finished the final round, mark as finished; otherwise continue game loop
             if (currentRound > ArcheryConfig::TOTAL_ROUNDS)
@@ -164,6 +200,7 @@ bool ArcheryChallenge::run()
             rgbLed.off();
             showTimer = true;
             state = ArcheryState::GameLoop;
+            requestCheckpoint();
         }
         break;
 
@@ -184,7 +221,7 @@ bool ArcheryChallenge::run()
  */
 bool ArcheryChallenge::updateRoundAttempt(int roundLevel)
 {
-    unsigned long now = millis();
+    unsigned long now = Clock::now();
     bool currentState = isButtonPressed();
 
     switch (roundState)
@@ -200,8 +237,8 @@ bool ArcheryChallenge::updateRoundAttempt(int roundLevel)
         // Generate random target value
         targetValue = generateRandomTarget();
 
-        // Print target value for debugging
-        Serial.println("Round " + String(roundLevel) + " target value: " + String(targetValue));
+        // Log target value for debugging (debug builds only, it gives the answer away)
+        LOG_DEBUG(ARCHERY, ArcheryTarget, roundLevel, targetValue);
 
         // Select random magical effect
         currentEffect = selectRandomEffect();
@@ -260,7 +297,7 @@ bool ArcheryChallenge::updateRoundAttempt(int roundLevel)
             int potValue = readPotentiometer();
             bool hit = checkHit(potValue);
 
-            Serial.println("Arrow fired! Pot value: " + String(potValue) + ", Hit: " + String(hit));
+            LOG_DEBUG(ARCHERY, ArcheryArrow, potValue, hit);
 
             // Process hit with shield effect
             bool shieldBlocked = false;
@@ -318,10 +355,10 @@ bool ArcheryChallenge::updateRoundAttempt(int roundLevel)
         {
             lcd.clear();
             lcd.setCursor(0, 0);
-            lcd.print("Round ");
-            lcd.print(roundLevel);
+            lcd.print(StringId::RoundPrefix);
+            lcd.print(Fmt::unsignedField<1>(roundLevel).text);
             lcd.setCursor(0, 1);
-            lcd.print("Aim and Fire!");
+            lcd.print(StringId::AimAndFire);
             rgbLed.off();
             showTimer = true;
             roundState = RoundAttemptState::Playing;
@@ -367,10 +404,10 @@ void ArcheryChallenge::runRestartEffect()
     whadda.blinkLEDs(0xFF, 3, ArcheryConfig::RESTART_BLINK_INTERVAL);
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print("Out of arrows...");
+    lcd.print(StringId::OutOfArrows);
     lcd.setCursor(0, 1);
-    lcd.print("Try again!");
-    whadda.displayText("RESTART");
+    lcd.print(StringId::TryAgain);
+    whadda.displayText(StringId::RestartBanner);
 }
 
 // ===== Helper Methods =====
@@ -379,17 +416,17 @@ void ArcheryChallenge::runRestartEffect()
  * @brief Displays a message on the LCD screen.
  *
  * @param line1 First line of text to display
- * @param line2 Second line of text to display (optional)
+ * @param line2 Second line of text to display (StringId::Count for none)
  * @param hideTimer Whether to hide the timer during this message
  */
-void ArcheryChallenge::displayLcdMessage(const char* line1, const char* line2, bool hideTimer)
+void ArcheryChallenge::displayLcdMessage(StringId line1, StringId line2, bool hideTimer)
 {
     lcd.clear();
     lcd.setCursor(0, 0);
     showTimer = !hideTimer;
     lcd.print(line1);
     
-    if (line2 != nullptr)
+    if (line2 != StringId::Count)
     {
         lcd.setCursor(0, 1);
         lcd.print(line2);
@@ -405,8 +442,8 @@ void ArcheryChallenge::displayRoundInfo(int roundLevel)
 {
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print("Round ");
-    lcd.print(roundLevel);
+    lcd.print(StringId::RoundPrefix);
+    lcd.print(Fmt::unsignedField<1>(roundLevel).text);
 }
 
 /**
@@ -420,15 +457,15 @@ void ArcheryChallenge::displayEffectInfo(ArcheryEffect effect)
     
     if (effect == ArcheryEffect::Winds)
     {
-        lcd.print("Shifting Winds!");
+        lcd.print(StringId::ShiftingWinds);
     }
     else if (effect == ArcheryEffect::Disappear)
     {
-        lcd.print("Target flickers!");
+        lcd.print(StringId::TargetFlickers);
     }
     else if (effect == ArcheryEffect::Shield)
     {
-        lcd.print("Magic Shield!");
+        lcd.print(StringId::MagicShield);
     }
 }
 
@@ -442,11 +479,10 @@ void ArcheryChallenge::displayHitFeedback(int roundLevel)
     lcd.clear();
     lcd.setCursor(0, 0);
     showTimer = false;
-    lcd.print("Hit! Round ");
-    lcd.print(roundLevel);
+    lcd.print(StringId::HitRoundPrefix);
+    lcd.print(Fmt::unsignedField<1>(roundLevel).text);
     lcd.setCursor(0, 1);
-    lcd.print("Target ");
-    lcd.print(" clear!");
+    lcd.print(StringId::TargetClear);
     
     // Play a celebratory tone for the hit
     playHitSound();
@@ -467,7 +503,7 @@ void ArcheryChallenge::displayMissFeedback(bool shieldBlocked, bool targetVisibl
     
     if (shieldBlocked)
     {
-        lcd.print("Blocked by Shield!");
+        lcd.print(StringId::BlockedByShield);
         playShieldBlockSound();
     }
     else if (targetVisible)
@@ -475,17 +511,17 @@ void ArcheryChallenge::displayMissFeedback(bool shieldBlocked, bool targetVisibl
         // Indicate if the shot was too high or too low
         if (potValue > targetValue)
         {
-            lcd.print("Too high!");
+            lcd.print(StringId::TooHigh);
         }
         else
         {
-            lcd.print("Too low!");
+            lcd.print(StringId::TooLow);
         }
         playMissSound();
     }
     else
     {
-        lcd.print("Target invisible!");
+        lcd.print(StringId::TargetInvisible);
         playMissSound();
     }
 
@@ -504,9 +540,9 @@ void ArcheryChallenge::displayRetryMessage()
     lcd.clear();
     lcd.setCursor(0, 0);
     showTimer = false;
-    lcd.print("Out of arrows...");
+    lcd.print(StringId::OutOfArrows);
     lcd.setCursor(0, 1);
-    lcd.print("Restarting");
+    lcd.print(StringId::Restarting);
 }
 
 /**
@@ -516,10 +552,10 @@ void ArcheryChallenge::displayFinishedMessage()
 {
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print("Challenge Done!");
-    buzzer.playWinMelody();
+    lcd.print(StringId::ChallengeDone);
+    buzzer.playMelody(MelodyId::Win);
     rgbLed.off();
-    Serial.println("Game 3 completed!");
+    LOG_INFO(ARCHERY, ArcheryCompleted);
 }
 
 /**
@@ -555,13 +591,13 @@ int ArcheryChallenge::getToleranceForRound(int roundLevel)
     switch (roundLevel)
     {
     case 1:
-        return ArcheryConfig::TOLERANCE_ROUND1;
+        return tuning.archeryToleranceRound1;
     case 2:
-        return ArcheryConfig::TOLERANCE_ROUND2;
+        return tuning.archeryToleranceRound2;
     case 3:
-        return ArcheryConfig::TOLERANCE_ROUND3;
+        return tuning.archeryToleranceRound3;
     default:
-        return ArcheryConfig::TOLERANCE_ROUND1;
+        return tuning.archeryToleranceRound1;
     }
 }
 
@@ -603,7 +639,7 @@ ArcheryEffect ArcheryChallenge::selectRandomEffect()
  */
 bool ArcheryChallenge::isButtonPressed()
 {
-    return digitalRead(BTN_PIN) == LOW;
+    return button.isDown();
 }
 
 /**
@@ -613,7 +649,7 @@ bool ArcheryChallenge::isButtonPressed()
  */
 int ArcheryChallenge::readPotentiometer()
 {
-    int raw = analogRead(POT_PIN);
+    int raw = Stimulus::analogRead(POT_PIN);
     return constrain(map(raw, 
                          ArcheryConfig::POT_MIN_RAW, 
                          ArcheryConfig::POT_MAX_RAW, 
@@ -704,6 +740,7 @@ void ArcheryChallenge::handleDisappearEffect(unsigned long now)
 void ArcheryChallenge::fireArrow()
 {
     arrowCount++;
+    Telemetry::archeryArrow(currentRound);
     buzzer.playTone(ArcheryConfig::ARROW_FIRE_FREQ, ArcheryConfig::ARROW_FIRE_DURATION);
 }
 
@@ -1,5 +1,11 @@
 #include "EscapeVelocity.h"
 #include "Globals.h"
+#include "Tuning.h"
+#include "Telemetry.h"
+#include "Profiler.h"
+#include "Stimulus.h"
+#include "Fmt.h"
+#include "Log.h"
 
 /**
  * @brief Constructor for the Escape Velocity game
@@ -9,6 +15,8 @@
 EscapeVelocity::EscapeVelocity() : state(EscVelocityState::Init),
                                    currentGate(1),
                                    lives(EscVelocityConfig::STARTING_LIVES),
+                                   resumeGate(1),
+                                   resumeLives(EscVelocityConfig::STARTING_LIVES),
                                    stateStart(0),
                                    gateResult(false),
                                    showTimerFlag(true),
@@ -34,7 +42,7 @@ EscapeVelocity::EscapeVelocity() : state(EscVelocityState::Init),
  */
 int EscapeVelocity::getSmoothedPotValue(int gateLevel)
 {
-    int raw = analogRead(POT_PIN);
+    int raw = Stimulus::analogRead(POT_PIN);
     int mapped = constrain(map(raw, 
                               EscVelocityConfig::POT_MIN_RAW, 
                               EscVelocityConfig::POT_MAX_RAW, 
@@ -53,7 +61,7 @@ int EscapeVelocity::getSmoothedPotValue(int gateLevel)
  */
 void EscapeVelocity::initPotFilter()
 {
-    potFilter = (float)analogRead(POT_PIN);
+    potFilter = (float)Stimulus::analogRead(POT_PIN);
 }
 
 /**
@@ -100,13 +108,8 @@ void EscapeVelocity::generateVelocityRange(int gateLevel, int &minVel, int &maxV
     if (maxVel > maxPossible)
         maxVel = maxPossible;
 
-    // Debug output
-    Serial.print("[Gate ");
-    Serial.print(gateLevel);
-    Serial.print("] Range: ");
-    Serial.print(minVel);
-    Serial.print(" - ");
-    Serial.println(maxVel);
+    // Debug output (debug builds only, it gives the answer away)
+    LOG_DEBUG(ESCAPE, EscapeGateRange, gateLevel, minVel, maxVel);
 }
 
 /**
@@ -120,10 +123,10 @@ void EscapeVelocity::generateVelocityRange(int gateLevel, int &minVel, int &maxV
 void EscapeVelocity::updateGateDisplays(int gateLevel, int potValue)
 {
     lcd.setCursor(0, 0);
-    lcd.print("Gate ");
-    lcd.print(gateLevel);
-    char buff[16];
-    sprintf(buff, "Spd %4d", potValue);
+    lcd.print(StringId::GatePrefix);
+    lcd.print(Fmt::unsignedField<1>(gateLevel).text);
+    char buff[9] = "Spd ";
+    Fmt::writeSigned<4>(buff + 4, potValue);
     whadda.displayText(buff);
 }
 
@@ -137,8 +140,8 @@ void EscapeVelocity::updateGateDisplays(int gateLevel, int potValue)
  */
 bool EscapeVelocity::isPotInRange(int potValue, int minVel, int maxVel)
 {
-    int minCheck = minVel - EscVelocityConfig::TOLERANCE;
-    int maxCheck = maxVel + EscVelocityConfig::TOLERANCE;
+    int minCheck = minVel - tuning.escapeTolerance;
+    int maxCheck = maxVel + tuning.escapeTolerance;
     return (potValue >= minCheck && potValue <= maxCheck);
 }
 
@@ -174,7 +177,7 @@ void EscapeVelocity::handleGateSuccess()
     // Gate passed – play a short beep sequence.
     buzzer.playTone(EscVelocityConfig::SUCCESS_TONE1_FREQ, EscVelocityConfig::SUCCESS_TONE1_DURATION);
     buzzer.playTone(EscVelocityConfig::SUCCESS_TONE2_FREQ, EscVelocityConfig::SUCCESS_TONE2_DURATION);
-    stateStart = millis();
+    stateStart = Clock::now();
     state = EscVelocityState::SuccessBeep;
 }
 
@@ -187,20 +190,23 @@ void EscapeVelocity::handleGateSuccess()
 void EscapeVelocity::handleGateFailure()
 {
     // Gate failed – lose a life.
-    Serial.println("Gate failed. Current lives: " + String(lives));
+    LOG_INFO(ESCAPE, EscapeGateFailed, lives);
     lives--;
+    Telemetry::escapeGateFailed();
     setWhaddaLives(lives);
     buzzer.playTone(EscVelocityConfig::FAILED_TONE_FREQ, EscVelocityConfig::FAILED_TONE_DURATION);
     if (lives <= 0)
     {
-        stateStart = millis();
+        Telemetry::escapeOutOfLives();
+        stateStart = Clock::now();
         state = EscVelocityState::RestartEffect;
     }
     else
     {
-        stateStart = millis();
+        stateStart = Clock::now();
         state = EscVelocityState::FailedPause;
     }
+    requestCheckpoint();
 }
 
 /**
@@ -216,10 +222,11 @@ void EscapeVelocity::resetGame()
     lives = EscVelocityConfig::STARTING_LIVES;
     // Reset the gate attempt state
     gateState = GateAttemptState::Init;
-    Serial.println("SHOULD SET LIVES TO: " + String(lives));
+    LOG_DEBUG(ESCAPE, EscapeLivesReset, lives);
     setWhaddaLives(lives);
     showTimer = true;
     state = EscVelocityState::GameLoop;
+    requestCheckpoint();
 }
 
 /**
@@ -233,7 +240,7 @@ void EscapeVelocity::resetGame()
  */
 bool EscapeVelocity::updateGateAttempt(int gateLevel)
 {
-    unsigned long now = millis();
+    unsigned long now = Clock::now();
 
     switch (gateState)
     {
@@ -241,12 +248,12 @@ bool EscapeVelocity::updateGateAttempt(int gateLevel)
         generateVelocityRange(gateLevel, minVel, maxVel);
         lcd.clear();
         lcd.setCursor(0, 0);
-        lcd.print("Gate ");
-        lcd.print(gateLevel);
+        lcd.print(StringId::GatePrefix);
+        lcd.print(Fmt::unsignedField<1>(gateLevel).text);
         lcd.setCursor(0, 1);
-        lcd.print("Range:");
+        lcd.print(StringId::RangePrefix);
         lcd.print(minVel);
-        lcd.print("-");
+        lcd.print('-');
         lcd.print(maxVel);
         whadda.clearDisplay();
         initPotFilter();
@@ -291,7 +298,7 @@ bool EscapeVelocity::updateGateAttempt(int gateLevel)
                 wasOutOfRange = false;
                 inRangeStart = now;
             }
-            if (hasElapsed(inRangeStart, EscVelocityConfig::IN_RANGE_MS))
+            if (hasElapsed(inRangeStart, tuning.escapeInRangeMs))
             {
                 // Maintained in-range long enough: gate passed.
                 gateResult = true;
@@ -327,8 +334,37 @@ void EscapeVelocity::runRestartEffect()
     whadda.blinkLEDs(0xFF, 3, EscVelocityConfig::RESTART_BLINK_INTERVAL);
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print("Out of lives...");
-    whadda.displayText("Restarting...");
+    lcd.print(StringId::OutOfLives);
+    whadda.displayText(StringId::RestartingDots);
+}
+
+/**
+ * @brief Makes init() continue at a checkpointed gate with the same lives
+ *
+ * @param progress Value from getProgress(), ignored if out of range
+ */
+void EscapeVelocity::resumeFrom(uint32_t progress)
+{
+    int gate = progress & 0xFF;
+    int savedLives = (progress >> 8) & 0xFF;
+    if (gate < 1 || gate > EscVelocityConfig::TOTAL_GATES || savedLives < 1 || savedLives > EscVelocityConfig::STARTING_LIVES)
+        return;
+    resumeGate = gate;
+    resumeLives = savedLives;
+}
+
+/**
+ * @brief Returns the game to its initial state
+ *
+ * The next run() goes through init() and the intro again.
+ */
+void EscapeVelocity::reset()
+{
+    state = EscVelocityState::Init;
+    resumeGate = 1;
+    resumeLives = EscVelocityConfig::STARTING_LIVES;
+    whadda.clearDisplay();
+    rgbLed.off();
 }
 
 /**
@@ -339,12 +375,14 @@ void EscapeVelocity::runRestartEffect()
  */
 void EscapeVelocity::init()
 {
-    buzzer.playRoundStartMelody();
+    buzzer.playMelody(MelodyId::RoundStart);
     state = EscVelocityState::Init;
-    currentGate = 1;
-    lives = EscVelocityConfig::STARTING_LIVES;
+    currentGate = resumeGate;
+    lives = resumeLives;
+    resumeGate = 1;
+    resumeLives = EscVelocityConfig::STARTING_LIVES;
     setWhaddaLives(lives);
-    stateStart = millis();
+    stateStart = Clock::now();
     showTimerFlag = true;
     // Initialize gate attempt state
     gateState = GateAttemptState::Init;
@@ -360,7 +398,9 @@ void EscapeVelocity::init()
  */
 bool EscapeVelocity::run()
 {
-    unsigned long now = millis();
+    PROFILE_ZONE(ProfileZone::EscapeRun);
+
+    unsigned long now = Clock::now();
 
     switch (state)
     {
@@ -373,9 +413,9 @@ bool EscapeVelocity::run()
         lcd.clear();
         lcd.setCursor(0, 0);
         showTimer = false;
-        lcd.print("Escape Velocity!");
+        lcd.print(StringId::EscapeTitle);
         lcd.setCursor(0, 1);
-        lcd.print("Good luck!");
+        lcd.print(StringId::GoodLuck);
         stateStart = now;
         state = EscVelocityState::WaitIntro;
         break;
@@ -419,6 +459,7 @@ bool EscapeVelocity::run()
         {
             currentGate++;
             state = EscVelocityState::GameLoop;
+            requestCheckpoint();
         }
         break;
 
@@ -437,7 +478,7 @@ bool EscapeVelocity::run()
             lcd.clear();
             lcd.setCursor(0, 0);
             showTimer = false;
-            lcd.print("Retrying...");
+            lcd.print(StringId::Retrying);
             stateStart = now;
             state = EscVelocityState::Retry;
         }
@@ -453,10 +494,10 @@ bool EscapeVelocity::run()
     case EscVelocityState::Finished:
         lcd.clear();
         lcd.setCursor(0, 0);
-        lcd.print("Challenge Done!");
-        buzzer.playWinMelody();
+        lcd.print(StringId::ChallengeDone);
+        buzzer.playMelody(MelodyId::Win);
         rgbLed.off();
-        Serial.println("Game 2 completed!");
+        LOG_INFO(ESCAPE, EscapeCompleted);
         return true;
     }
     return false;
@@ -1,7 +1,9 @@
 #include "MemoryGame.h"
 #include "Globals.h"
-
-#define DEBUG_MEMORY_GAME
+#include "Tuning.h"
+#include "Telemetry.h"
+#include "Log.h"
+#include "Profiler.h"
 
 
 /**
@@ -17,19 +19,20 @@ MemoryGame::MemoryGame() : currentState(MemoryGameState::Idle),
                            challengeComplete(false),
                            displayStarted(false),
                            level(0),
+                           startLevel(1),
                            seqLength(0),
                            userIndex(0),
-                           lastButtonPressed(MemoryGameConfig::NO_BUTTON_PRESSED),
                            blinkCount(0),
                            blinkMask(MemoryGameConfig::ALL_LEDS_MASK),
                            lastStateChangeTime(0),
                            lastActionTime(0),
-                           lastPressTime(0),
+                           lastInputUs(0),
                            inputDelayStart(0),
                            errorDelayStart(0),
                            finishDelayStart(0),
                            levelDelayStart(0),
-                           seqDisplayIndex(0)
+                           seqDisplayIndex(0),
+                           keyEvents(MemoryGameConfig::KEY_LOCKOUT_US)
 {
 }
 
@@ -43,11 +46,11 @@ void MemoryGame::init()
 {
     if (!challengeInitialized)
     {
-        buzzer.playRoundStartMelody();
+        buzzer.playMelody(MelodyId::RoundStart);
         lcd.setCursor(0, 0);
-        lcd.print(MemoryGameConfig::GAME_TITLE);
+        lcd.print(StringId::MemoryTitle);
         lcd.setCursor(0, 1);
-        lcd.print(MemoryGameConfig::GOOD_LUCK_MESSAGE);
+        lcd.print(StringId::MemoryGoodLuck);
         challengeInitialized = true;
         challengeComplete = false;
         whadda.clearDisplay();
@@ -63,7 +66,7 @@ void MemoryGame::init()
 void MemoryGame::setState(MemoryGameState newState)
 {
     currentState = newState;
-    lastStateChangeTime = millis();
+    lastStateChangeTime = Clock::now();
 }
 
 /**
@@ -86,6 +89,9 @@ void MemoryGame::resetSequenceDisplay()
  */
 int MemoryGame::getSequenceLengthForLevel(int lvl) const
 {
+    if (tuning.memoryAppendMode)
+        return MemoryGameConfig::INITIAL_SEQUENCE_LENGTH + (lvl - 1) * MemoryGameConfig::APPEND_STEPS_PER_LEVEL;
+
     if (lvl <= MemoryGameConfig::LEVEL_2_THRESHOLD)
         return MemoryGameConfig::INITIAL_SEQUENCE_LENGTH;
     else if (lvl <= MemoryGameConfig::LEVEL_4_THRESHOLD)
@@ -103,7 +109,7 @@ int MemoryGame::getSequenceLengthForLevel(int lvl) const
  */
 void MemoryGame::update7SegmentDisplay() const
 {
-    int dotCount = (level <= MemoryGameConfig::MAX_LEVEL) ? level : MemoryGameConfig::MAX_LEVEL;
+    int dotCount = (level <= tuning.memoryMaxLevel) ? level : tuning.memoryMaxLevel;
     for (uint8_t pos = 0; pos < MemoryGameConfig::MAX_LEVEL; pos++)
     {
         whadda.display7Seg(pos, (pos < dotCount) ? 1 : 0);
@@ -111,53 +117,58 @@ void MemoryGame::update7SegmentDisplay() const
 }
 
 /**
- * @brief Generates a random sequence of the given length
+ * @brief Brings the sequence to the given length
  * 
  * @param length The length of the sequence to generate
  * 
- * The sequence is generated randomly, but with a constraint to prevent
- * four identical consecutive values, which would make the game too easy.
+ * Normally every level draws a fresh sequence. In append mode (MemoryAppendMode)
+ * the sequence of the previous level is kept and only the new steps are drawn,
+ * so each level replays the last one plus its additions. A game start, or a
+ * shorter length, starts over.
  */
 void MemoryGame::generateSequence(int length)
 {
     if (length > MemoryGameConfig::MAX_SEQUENCE_SIZE)
         length = MemoryGameConfig::MAX_SEQUENCE_SIZE;
 
-    sequence[0] = random(0, MemoryGameConfig::NUM_LEDS);
-    for (int i = 1; i < length; i++)
-    {
-        // Prevent four identical consecutive values
-        if (i >= 3 &&
-            sequence[i - 1] == sequence[i - 2] &&
-            sequence[i - 2] == sequence[i - 3])
-        {
-            int newVal;
-            do
-            {
-                newVal = random(0, MemoryGameConfig::NUM_LEDS);
-            } while (newVal == sequence[i - 1]);
-            sequence[i] = newVal;
-        }
-        else
-        {
-            sequence[i] = random(0, MemoryGameConfig::NUM_LEDS);
-        }
-    }
+    if (!tuning.memoryAppendMode || length < sequence.size())
+        sequence.clear();
+
+    while (sequence.size() < length)
+        sequence.append(nextStep());
 
-    // Debug output
-    #ifdef DEBUG_MEMORY_GAME
-    Serial.print("Generated sequence: ");
+    // Debug output (debug builds only, it gives the answer away)
+    #if LOG_ENABLED(MEMORY, DEBUG)
+    // Pack the LED indices as nibbles, 8 steps per argument
+    int32_t packed[4] = {0, 0, 0, 0};
     for (int i = 0; i < length; i++)
     {
-        Serial.print("LED");
-        Serial.print(sequence[i] + 1);
-        if (i < length - 1)
-            Serial.print(" -> ");
+        packed[i / 8] |= (int32_t)sequence[i] << ((i % 8) * 4);
     }
-    Serial.println();
+    LOG_DEBUG(MEMORY, MemorySequence, length, packed[0], packed[1], packed[2], packed[3]);
     #endif
 }
 
+/**
+ * @brief Draws the next step of the sequence
+ * 
+ * @return An LED index
+ * 
+ * Four identical consecutive values would make the game too easy. Once the
+ * last value has run MAX_REPEAT times, the step is drawn from the other
+ * LEDs only: one draw over NUM_LEDS - 1 values, skipping past the repeated
+ * one, instead of redrawing until it differs.
+ */
+uint8_t MemoryGame::nextStep() const
+{
+    if (sequence.size() > 0 && sequence.trailingRun() >= MemoryGameConfig::MAX_REPEAT)
+    {
+        uint8_t value = random(0, MemoryGameConfig::NUM_LEDS - 1);
+        return value >= sequence.back() ? value + 1 : value;
+    }
+    return random(0, MemoryGameConfig::NUM_LEDS);
+}
+
 /**
  * @brief Updates the start animation
  * 
@@ -173,7 +184,7 @@ bool MemoryGame::updateStartAnimation()
     case StartAnimPhase::Idle:
         blinkCount = 0;
         startAnimPhase = StartAnimPhase::BlinkOn;
-        lastActionTime = millis();
+        lastActionTime = Clock::now();
         whadda.clearDisplay();
         return false;
     case StartAnimPhase::BlinkOn:
@@ -181,7 +192,7 @@ bool MemoryGame::updateStartAnimation()
         if (hasElapsed(lastActionTime, MemoryGameConfig::START_ANIM_INTERVAL))
         {
             startAnimPhase = StartAnimPhase::BlinkOff;
-            lastActionTime = millis();
+            lastActionTime = Clock::now();
         }
         return false;
     case StartAnimPhase::BlinkOff:
@@ -192,13 +203,13 @@ bool MemoryGame::updateStartAnimation()
             if (blinkCount < MemoryGameConfig::REQUIRED_BLINKS)
             {
                 startAnimPhase = StartAnimPhase::BlinkOn;
-                lastActionTime = millis();
+                lastActionTime = Clock::now();
             }
             else
             {
                 buzzer.playTone(MemoryGameConfig::START_TONE_FREQUENCY, MemoryGameConfig::START_TONE_DURATION);
                 startAnimPhase = StartAnimPhase::Done;
-                lastActionTime = millis();
+                lastActionTime = Clock::now();
             }
         }
         return false;
@@ -208,6 +219,31 @@ bool MemoryGame::updateStartAnimation()
     return false; // Fallback
 }
 
+/**
+ * @brief Starts the next game at a checkpointed level
+ *
+ * @param progress Level from getProgress(), ignored if out of range
+ */
+void MemoryGame::resumeFrom(uint32_t progress)
+{
+    if (progress >= 1 && progress <= (uint32_t)tuning.memoryMaxLevel)
+        startLevel = progress;
+}
+
+/**
+ * @brief Returns the game to its initial state
+ *
+ * The intro is shown again on the next run().
+ */
+void MemoryGame::reset()
+{
+    challengeInitialized = false;
+    challengeComplete = false;
+    startLevel = 1;
+    clearVisualFeedback();
+    setState(MemoryGameState::Idle);
+}
+
 /**
  * @brief Starts the game by initializing variables and generating the first sequence
  * 
@@ -216,13 +252,15 @@ bool MemoryGame::updateStartAnimation()
 void MemoryGame::startGame()
 {
     challengeComplete = false;
-    level = 1;
+    // A resumed session continues at its checkpointed level once, retries start over
+    level = startLevel;
+    startLevel = 1;
     seqLength = getSequenceLengthForLevel(level);
     userIndex = 0;
-    lastButtonPressed = MemoryGameConfig::NO_BUTTON_PRESSED;
-    lastPressTime = 0;
 
+    sequence.clear();
     generateSequence(seqLength);
+    tempo.begin(tuning.memoryTempoMinPercent, tuning.memoryTempoMaxPercent);
     resetSequenceDisplay();
     update7SegmentDisplay();
     startAnimPhase = StartAnimPhase::Idle;
@@ -245,21 +283,21 @@ void MemoryGame::updateSequenceDisplay()
             {
                 uint16_t ledMask = (1 << sequence[seqDisplayIndex]) << MemoryGameConfig::LED_SHIFT_AMOUNT;
                 whadda.setLEDs(ledMask);
-                buzzer.playTone(Frequencies::ledFrequencies[sequence[seqDisplayIndex]], MemoryGameConfig::TONE_DURATION_SEQUENCE);
-                lastActionTime = millis();
+                buzzer.playTone(Frequencies::ledFrequencies[sequence[seqDisplayIndex]], tempo.scale(MemoryGameConfig::TONE_DURATION_SEQUENCE));
+                lastActionTime = Clock::now();
                 displayStarted = true;
             }
-            else if (hasElapsed(lastActionTime, MemoryGameConfig::LED_ON_TIME))
+            else if (hasElapsed(lastActionTime, tempo.scale(MemoryGameConfig::LED_ON_TIME)))
             {
                 whadda.clearLEDs();
-                lastActionTime = millis();
+                lastActionTime = Clock::now();
                 displayStarted = false;
                 seqPhase = SeqPhase::LedOff;
             }
         }
         else
         { // SeqPhase::LedOff
-            if (hasElapsed(lastActionTime, MemoryGameConfig::LED_OFF_TIME))
+            if (hasElapsed(lastActionTime, tempo.scale(MemoryGameConfig::LED_OFF_TIME)))
             {
                 seqDisplayIndex++;
                 seqPhase = SeqPhase::LedOn;
@@ -271,57 +309,68 @@ void MemoryGame::updateSequenceDisplay()
         whadda.clearLEDs();
         userIndex = 0;
         update7SegmentDisplay();
+        // Presses made while the sequence played are not answers
+        keyEvents.clear();
+        lastInputUs = micros();
         setState(MemoryGameState::GetUserInput);
     }
 }
 
 
 /**
- * @brief Checks for user input and processes it
+ * @brief Takes the next queued key press and checks it against the sequence
  * 
- * This method reads the button inputs, handles debouncing, and checks if the input
- * matches the expected sequence. It provides visual and audio feedback based on the input.
+ * Presses are handled in the order they happened, one per call, so a fast
+ * player's next key waits in the queue while the feedback of the previous
+ * one plays. With MemoryChordWindowMs set, a press followed by another within
+ * that window counts as pressing keys together and is an error.
  */
 void MemoryGame::checkUserInput()
 {
-    uint8_t buttons = whadda.readButtonsWithDebounce();
-    if (buttons == 0)
-    {
-        lastButtonPressed = MemoryGameConfig::NO_BUTTON_PRESSED;
+    KeyEvent press;
+    if (!keyEvents.peek(press))
         return;
-    }
 
-    for (int btnIndex = 0; btnIndex < MemoryGameConfig::NUM_LEDS; btnIndex++)
+    bool chord = false;
+    if (tuning.memoryChordWindowMs > 0)
     {
-        if (buttons & (1 << btnIndex))
-        {
-            unsigned long now = millis();
-            if (btnIndex == lastButtonPressed && (now - lastPressTime) < MemoryGameConfig::BUTTON_DEBOUNCE_DELAY)
-                return;
+        uint32_t windowUs = (uint32_t)tuning.memoryChordWindowMs * 1000;
+        KeyEvent next;
+        if (keyEvents.peek(next, 1))
+            chord = next.timeUs - press.timeUs < windowUs;
+        else if (micros() - press.timeUs < windowUs)
+            return; // A second key may still follow within the window
+    }
+    keyEvents.pop(press);
 
-            lastPressTime = now;
-            lastButtonPressed = btnIndex;
+    unsigned long now = Clock::now();
+    tempo.recordResponse((press.timeUs - lastInputUs) / 1000);
+    lastInputUs = press.timeUs;
 
-            if (btnIndex == sequence[userIndex])
-            {
-                buzzer.playTone(Frequencies::ledFrequencies[btnIndex], MemoryGameConfig::TONE_DURATION_INPUT);
-                whadda.setLEDs((1 << btnIndex) << MemoryGameConfig::LED_SHIFT_AMOUNT);
-                inputDelayStart = now;
-                userIndex++;
-
-                if (userIndex >= seqLength)
-                    setState(MemoryGameState::RoundWinCheck);
-                else
-                    setState(MemoryGameState::WaitInputDelay);
-            }
-            else
-            {
-                displayErrorFeedback();
-                errorDelayStart = now;
-                setState(MemoryGameState::Error);
-            }
-            break; // Process one button press at a time
+    if (!chord && press.key == sequence[userIndex])
+    {
+        buzzer.playTone(Frequencies::ledFrequencies[press.key], MemoryGameConfig::TONE_DURATION_INPUT);
+        whadda.setLEDs((1 << press.key) << MemoryGameConfig::LED_SHIFT_AMOUNT);
+        inputDelayStart = now;
+        userIndex++;
+
+        if (userIndex >= seqLength)
+        {
+            adaptTempo(false);
+            setState(MemoryGameState::RoundWinCheck);
         }
+        else
+            setState(MemoryGameState::WaitInputDelay);
+    }
+    else
+    {
+        keyEvents.clear();
+        displayErrorFeedback();
+        Telemetry::memoryError(level);
+        adaptTempo(true);
+        errorDelayStart = now;
+        setState(MemoryGameState::Error);
+        requestCheckpoint();
     }
 }
 
@@ -337,7 +386,7 @@ void MemoryGame::checkUserInput()
 void MemoryGame::displayErrorFeedback()
 {
     buzzer.playTone(MemoryGameConfig::ERROR_TONE_FREQUENCY, MemoryGameConfig::ERROR_TONE_DURATION);
-    whadda.displayText(MemoryGameConfig::ERROR_MESSAGE);
+    whadda.displayText(StringId::MemoryError);
 }
 
 /**
@@ -348,8 +397,8 @@ void MemoryGame::displayErrorFeedback()
 void MemoryGame::displaySuccessFeedback()
 {
     whadda.clearDisplay();
-    whadda.displayText(MemoryGameConfig::SUCCESS_MESSAGE);
-    buzzer.playWinMelody();
+    whadda.displayText(StringId::MemorySuccess);
+    buzzer.playMelody(MelodyId::Win);
 }
 
 /**
@@ -387,10 +436,10 @@ void MemoryGame::clearVisualFeedback()
 void MemoryGame::handleRoundWin()
 {
     rgbLed.off();
-    if (level >= MemoryGameConfig::MAX_LEVEL)
+    if (level >= tuning.memoryMaxLevel)
     {
         displaySuccessFeedback();
-        finishDelayStart = millis();
+        finishDelayStart = Clock::now();
         rgbLed.startBlinkColor(0, 255, 0, 3);
         setState(MemoryGameState::Finish);
     }
@@ -398,12 +447,90 @@ void MemoryGame::handleRoundWin()
     {
         level++;
         displayLevelProgress();
-        levelDelayStart = millis();
+        levelDelayStart = Clock::now();
         setState(MemoryGameState::WaitNextLevel);
+        requestCheckpoint();
     }
 }
 
 
+/**
+ * @brief Adapts the tempo to the round just played
+ * 
+ * @param failed The round ended with a wrong button
+ * 
+ * Every decision is logged with its inputs, so captures show how the tempo
+ * followed each group and what it did to their time in the room.
+ */
+void MemoryGame::adaptTempo(bool failed)
+{
+    tempo.endRound(failed);
+    LOG_INFO(MEMORY, MemoryTempo, level, failed, tempo.getScalePermille(), tempo.getLatencyMs(), tempo.getErrorRatePermille());
+}
+
+//
+// Adaptive Tempo
+//
+
+MemoryTempo::MemoryTempo() : minPermille(1000),
+                             maxPermille(1000),
+                             scalePermille(1000),
+                             latencyMs(0),
+                             errorRatePermille(0)
+{
+}
+
+/**
+ * @brief Starts a session at the nominal tempo, or the nearest bound
+ */
+void MemoryTempo::begin(int minPercent, int maxPercent)
+{
+    minPermille = minPercent * 10;
+    maxPermille = maxPercent * 10;
+    scalePermille = 1000;
+    if (scalePermille < minPermille)
+        scalePermille = minPermille;
+    if (scalePermille > maxPermille)
+        scalePermille = maxPermille;
+
+    // Neither fast nor slow until the players have shown otherwise
+    latencyMs = (MemoryGameConfig::TEMPO_FAST_LATENCY_MS + MemoryGameConfig::TEMPO_SLOW_LATENCY_MS) / 2;
+    errorRatePermille = 0;
+}
+
+/**
+ * @brief Folds one step's response time into the average (1/8 weight)
+ * 
+ * Samples are capped at twice the slow threshold, so a single long pause
+ * does not hold the average up for many rounds.
+ */
+void MemoryTempo::recordResponse(unsigned long responseMs)
+{
+    const unsigned long cap = 2UL * MemoryGameConfig::TEMPO_SLOW_LATENCY_MS;
+    uint16_t sample = responseMs < cap ? responseMs : cap;
+    latencyMs = latencyMs + ((int32_t)sample - latencyMs) / 8;
+}
+
+/**
+ * @brief Updates the error rate (1/4 weight) and steps the tempo
+ */
+void MemoryTempo::endRound(bool failed)
+{
+    errorRatePermille = errorRatePermille + ((failed ? 1000 : 0) - (int32_t)errorRatePermille) / 4;
+
+    int32_t next = scalePermille;
+    if (failed || latencyMs > MemoryGameConfig::TEMPO_SLOW_LATENCY_MS)
+        next += MemoryGameConfig::TEMPO_SLOWDOWN_PERMILLE;
+    else if (latencyMs < MemoryGameConfig::TEMPO_FAST_LATENCY_MS && errorRatePermille < MemoryGameConfig::TEMPO_LOW_ERROR_PERMILLE)
+        next -= MemoryGameConfig::TEMPO_SPEEDUP_PERMILLE;
+
+    if (next < minPermille)
+        next = minPermille;
+    if (next > maxPermille)
+        next = maxPermille;
+    scalePermille = next;
+}
+
 /**
  * @brief Main game loop method
  * 
@@ -414,11 +541,16 @@ void MemoryGame::handleRoundWin()
  */
 bool MemoryGame::run()
 {
+    PROFILE_ZONE(ProfileZone::MemoryRun);
+
     if (!challengeInitialized)
         init();
     if (challengeComplete)
         return true;
 
+    // Scanned in every state, so a press is never missed between two checks
+    keyEvents.scan(whadda.readButtons(), micros());
+
     switch (currentState)
     {
     case MemoryGameState::Idle:
@@ -449,7 +581,8 @@ bool MemoryGame::run()
         checkUserInput();
         break;
     case MemoryGameState::WaitInputDelay:
-        if (hasElapsed(inputDelayStart, MemoryGameConfig::INPUT_FEEDBACK_TIME))
+        // The feedback ends early when the next press is already waiting
+        if (keyEvents.size() > 0 || hasElapsed(inputDelayStart, MemoryGameConfig::INPUT_FEEDBACK_TIME))
         {
             whadda.clearLEDs();
             setState(MemoryGameState::GetUserInput);
@@ -459,7 +592,7 @@ bool MemoryGame::run()
         rgbLed.blinkColor(255, 0, 0, 3);
         showTimer = false;
         lcd.setCursor(0, 0);
-        lcd.print(MemoryGameConfig::WATCH_CAREFULLY_MESSAGE);
+        lcd.print(StringId::WatchCarefully);
         if (hasElapsed(errorDelayStart, MemoryGameConfig::ERROR_DISPLAY_TIME))
         {
             lcd.clear();
@@ -497,18 +630,3 @@ bool MemoryGame::run()
     }
     return challengeComplete;
 }
-
-/**
- * @brief Global instance of the MemoryGame
- */
-MemoryGame memoryGame;
-
-/**
- * @brief Global run function that delegates to the MemoryGame instance
- * 
- * @return true when the game is complete, false otherwise
- */
-bool run()
-{
-    return memoryGame.run();
-}
@@ -1,5 +1,132 @@
 #include "RunnerGame.h"
 #include "Globals.h"
+#include "Tuning.h"
+#include "Telemetry.h"
+#include "Profiler.h"
+#include "BusStats.h"
+#include "Log.h"
+
+#include <string.h>
+
+namespace
+{
+    using namespace RunnerGameConfig;
+
+    /**
+     * @brief One obstacle of a spawn pattern and the gap before the next one.
+     */
+    struct SpawnStep
+    {
+        ObstacleType type;
+        uint8_t gapAfter; // Cells until the next obstacle enters
+    };
+
+    struct SpawnPattern
+    {
+        const SpawnStep *steps;
+        uint8_t count;
+    };
+
+    const SpawnStep SINGLE_CACTUS[] = {{ObstacleType::CactusType1, 16}};
+    const SpawnStep CACTUS_PAIR[] = {{ObstacleType::CactusType2, 7}, {ObstacleType::CactusType1, 14}};
+    const SpawnStep BIRD_THEN_CACTUS[] = {{ObstacleType::Bird, 9}, {ObstacleType::CactusType1, 14}};
+    const SpawnStep SMALL_CACTUS_RUN[] = {{ObstacleType::CactusType2, 6}, {ObstacleType::CactusType2, 6}, {ObstacleType::Bird, 14}};
+    const SpawnStep BIRD_PAIR[] = {{ObstacleType::Bird, 6}, {ObstacleType::Bird, 14}};
+
+#define PATTERN(steps) {steps, sizeof(steps) / sizeof(SpawnStep)}
+    const SpawnPattern PATTERNS[] = {
+        PATTERN(SINGLE_CACTUS),
+        PATTERN(CACTUS_PAIR),
+        PATTERN(BIRD_THEN_CACTUS),
+        PATTERN(SMALL_CACTUS_RUN),
+        PATTERN(BIRD_PAIR),
+    };
+#undef PATTERN
+
+    constexpr uint8_t PATTERN_COUNT = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+    constexpr uint8_t OBSTACLE_INDEX_MASK = MAX_OBSTACLES - 1;
+
+    static_assert((MAX_OBSTACLES & OBSTACLE_INDEX_MASK) == 0, "ring capacity must be a power of two");
+    static_assert(MAX_OBSTACLES * MIN_OBSTACLE_GAP > LCD_COLS, "ring too small for the densest pattern");
+    static_assert(LCD_COLS <= 16, "lane masks are 16 bits");
+
+    /**
+     * @brief CGRAM slot layout.
+     *
+     * Obstacles all move in lockstep, so every obstacle of a type sits at the
+     * same pixel phase and one set of shifted glyphs serves them all. A glyph
+     * scrolled left by k pixels spills into the cell before it, the "lead"
+     * cell, which is only drawn while k > 0.
+     */
+    enum Slot : uint8_t
+    {
+        SLOT_LLAMA_FRONT,
+        SLOT_LLAMA_BACK,
+        SLOT_CACTUS_LEAD,   // Tall cactus: columns of CactusPart1 scrolled out of its first cell
+        SLOT_CACTUS_MIDDLE, // Tall cactus: rest of CactusPart1 and the start of CactusPart2
+        SLOT_CACTUS_TAIL,   // Both cacti: rest of CactusPart2
+        SLOT_SMALL_LEAD,    // Small cactus: columns of CactusPart2 scrolled out of its cell
+        SLOT_BIRD_LEAD,
+        SLOT_BIRD_TAIL,
+        SLOT_COUNT,
+        NO_SLOT = 0xFF
+    };
+
+    static_assert(SLOT_COUNT == CGRAM_SLOTS, "one glyph per CGRAM slot");
+
+    /**
+     * @brief Cells an obstacle covers: lead (column - 1), body (its column) and tail (column + 1).
+     */
+    struct ObstacleCells
+    {
+        uint8_t lead;
+        uint8_t body;
+        uint8_t tail;
+    };
+
+    const ObstacleCells OBSTACLE_CELLS[NUM_OBSTACLE_TYPES] = {
+        {SLOT_BIRD_LEAD, SLOT_BIRD_TAIL, NO_SLOT},                // Bird
+        {SLOT_CACTUS_LEAD, SLOT_CACTUS_MIDDLE, SLOT_CACTUS_TAIL}, // CactusType1
+        {SLOT_SMALL_LEAD, SLOT_CACTUS_TAIL, NO_SLOT},             // CactusType2
+    };
+
+    constexpr uint8_t BLANK_CELL = ' ';
+
+    constexpr uint8_t LLAMA_SLOTS = (1 << SLOT_LLAMA_FRONT) | (1 << SLOT_LLAMA_BACK);
+    constexpr uint8_t LEAD_SLOTS = (1 << SLOT_CACTUS_LEAD) | (1 << SLOT_SMALL_LEAD) | (1 << SLOT_BIRD_LEAD);
+
+    uint8_t slotsOf(const ObstacleCells &cells)
+    {
+        uint8_t slots = (1 << cells.lead) | (1 << cells.body);
+        if (cells.tail != NO_SLOT)
+            slots |= 1 << cells.tail;
+        return slots;
+    }
+
+    /**
+     * @brief Renders one cell of a pair of glyphs scrolled left.
+     *
+     * @param out   Bitmap of the cell.
+     * @param left  Glyph whose cell this is, nullptr for an empty cell.
+     * @param right Glyph in the cell to the right, nullptr for an empty cell.
+     * @param shift Pixel columns scrolled, 0 to CELL_PIXELS - 1.
+     */
+    void shiftCell(uint8_t *out, const uint8_t *left, const uint8_t *right, uint8_t shift)
+    {
+        for (uint8_t row = 0; row < 8; row++)
+        {
+            uint8_t pixels = left ? (uint8_t)(left[row] << shift) & 0x1F : 0;
+            if (right)
+                pixels |= right[row] >> (CELL_PIXELS - shift);
+            out[row] = pixels;
+        }
+    }
+
+    uint8_t obstacleRow(ObstacleType type)
+    {
+        return type == ObstacleType::Bird ? JUMP_ROW : GROUND_ROW;
+    }
+}
 
 /**
  * @brief Constructor for RunnerGame
@@ -9,17 +136,42 @@
  */
 RunnerGame::RunnerGame()
     : currentState(RunnerGameState::Idle),
-      lastUpdateTime(0),
+      simTime(0),
       gameStartTime(0),
-      cactusPos(RunnerGameConfig::INITIAL_CACTUS_POS),
       llamaRow(RunnerGameConfig::GROUND_ROW),
       isJumping(false),
       jumpStartTime(0),
       jumpButtonReleased(true),
+      jumpRequested(false),
+      jumpPressTime(0),
+      collisionPending(false),
+      collisionTime(0),
       score(0),
-      currentObstacleType(ObstacleType::CactusType1),
+      obstacleHead(0),
+      obstacleCount(0),
+      laneMask{0, 0},
+      worldTick(0),
+      ticksToSpawn(1),
+      patternIndex(0),
+      patternStep(0),
+      cgram{},
+      shownCells{},
+      slotsInUse(LLAMA_SLOTS),
+      subSteps(1),
+      pixelShift(0),
+      uploadUs(RunnerGameConfig::INITIAL_UPLOAD_US),
+      frameStats{},
+      cellsDirty(false),
+      lastRenderTime(0),
+#ifdef ENABLE_JUMP_LATENCY
+      jumpLatency{},
+      latencyPending(false),
+      latencyPressTime(0),
+#endif
       gameInterval(RunnerGameConfig::INITIAL_GAME_INTERVAL),
-      lastSpeedIncreaseTime(0),
+      levelIntervalMs{},
+      spawnGapPercent(100),
+      speedLevel(0),
       gameOverTime(0),
       animationState(0),
       lastAnimationTime(0),
@@ -38,12 +190,13 @@ void RunnerGame::init()
     lcd.init();
     lcd.backlight();
     lcd.clear();
+    loadGlyphs();
 
     // Display the welcome/idle screen on the LCD
     lcd.setCursor(0, 0);
-    lcd.print(RunnerGameConfig::WELCOME_MSG_LINE1);
+    lcd.print(StringId::RunnerTitle);
     lcd.setCursor(0, 1);
-    lcd.print(RunnerGameConfig::WELCOME_MSG_LINE2);
+    lcd.print(StringId::RunnerPrompt);
 
     // Clear the score display on Whadda
     whadda.clearDisplay();
@@ -51,6 +204,19 @@ void RunnerGame::init()
     currentState = RunnerGameState::Idle;
 }
 
+/**
+ * @brief Returns the game to its initial state
+ *
+ * Goes back to waiting for a jump; the button has to be released first so a
+ * held button does not start the run straight away.
+ */
+void RunnerGame::reset()
+{
+    currentState = RunnerGameState::Idle;
+    jumpButtonReleased = false;
+    rgbLed.off();
+}
+
 /**
  * @brief Starts a new game
  * 
@@ -60,19 +226,42 @@ void RunnerGame::startGame()
 {
     // Clear the entire screen at the start of a new game
     lcd.clear();
-
-    cactusPos = RunnerGameConfig::INITIAL_CACTUS_POS;
+    memset(shownCells, BLANK_CELL, sizeof(shownCells));
+
+    obstacleHead = 0;
+    obstacleCount = 0;
+    laneMask[RunnerGameConfig::JUMP_ROW] = 0;
+    laneMask[RunnerGameConfig::GROUND_ROW] = 0;
+    worldTick = 0;
+    ticksToSpawn = 1; // The first obstacle enters on the first step
+    patternIndex = 0; // Always open with the single cactus
+    patternStep = 0;
     llamaRow = RunnerGameConfig::GROUND_ROW;
     isJumping = false;
     score = 0;
     jumpButtonReleased = false;
+    button.wasPressed(); // Drop the press that started the run
+    jumpRequested = false;
+    collisionPending = false;
+#ifdef ENABLE_JUMP_LATENCY
+    latencyPending = false;
+#endif
     currentState = RunnerGameState::Playing;
-    lastUpdateTime = millis();
-    gameStartTime = millis();
-    lastSpeedIncreaseTime = millis();
-    gameInterval = RunnerGameConfig::INITIAL_GAME_INTERVAL;
+    gameStartTime = Clock::now();
+    simTime = gameStartTime;
+    for (uint8_t level = 0; level <= RunnerSchedule::MAX_LEVEL; level++)
+    {
+        levelIntervalMs[level] = RunnerSchedule::levelInterval(level, RunnerGameConfig::INITIAL_GAME_INTERVAL,
+                                                               RunnerGameConfig::MIN_GAME_INTERVAL, tuning.runnerSpeedFactorPermille);
+    }
+    updateGameSpeed(gameStartTime);
     animationState = 0;
-    lastAnimationTime = millis();
+    lastAnimationTime = Clock::now();
+    pixelShift = 0;
+    frameStats = RunnerFrameStats{0, 0, 0, RunnerGameConfig::MAX_SUB_STEPS};
+    planScroll();
+    cellsDirty = true;
+    lastRenderTime = gameStartTime - RunnerGameConfig::RENDER_INTERVAL;
 }
 
 /**
@@ -84,9 +273,12 @@ void RunnerGame::showGameOver()
 {
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print(RunnerGameConfig::GAME_OVER_MSG);
+    lcd.print(StringId::RunnerGameOver);
     currentState = RunnerGameState::GameOver;
-    gameOverTime = millis(); // Record when game over occurred
+    gameOverTime = Clock::now(); // Record when game over occurred
+    requestCheckpoint();
+    Telemetry::runnerDied(score);
+    reportFrameStats();
     playCollisionSound();
     showCollisionFeedback();
 }
@@ -101,19 +293,21 @@ void RunnerGame::showWinScreen()
     // Display the winning message
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print(RunnerGameConfig::WIN_MSG_LINE1);
+    lcd.print(StringId::RunnerWin);
     lcd.setCursor(0, 1);
-    lcd.print(RunnerGameConfig::WIN_MSG_LINE2);
+    lcd.print(StringId::RunnerSurvived);
 
     // Start blinking the LED with the win color
     rgbLed.startBlinkColor(RunnerGameConfig::WIN_LED_RED, RunnerGameConfig::WIN_LED_GREEN, RunnerGameConfig::WIN_LED_BLUE, RunnerGameConfig::WIN_BLINK_COUNT);
 
     // Play winning melody
-    buzzer.playWinMelody();
+    buzzer.playMelody(MelodyId::Win);
 
     // Set state to winning and record the start time
     currentState = RunnerGameState::Winning;
-    winStateStartTime = millis();
+    winStateStartTime = Clock::now();
+    reportFrameStats();
+    requestCheckpoint();
 }
 
 /**
@@ -137,7 +331,12 @@ bool RunnerGame::handleIdleState(bool jumpPressed)
 /**
  * @brief Handles the playing state logic
  * 
- * Updates the game state, checks for collisions, and draws the game graphics.
+ * The simulation advances in fixed steps of gameInterval, each at its own
+ * simulated time, so a late run() catches up instead of losing steps and the
+ * outcome does not depend on loop jitter. After a long stall only
+ * MAX_CATCH_UP_STEPS are simulated and the rest is dropped, so the game
+ * pauses rather than racing through obstacles the player never saw.
+ * Drawing is a separate pass, see render().
  * 
  * @param currentTime Current time in milliseconds
  * @param jumpPressed Whether the jump button is currently pressed
@@ -146,34 +345,45 @@ bool RunnerGame::handleIdleState(bool jumpPressed)
 bool RunnerGame::handlePlayingState(unsigned long currentTime, bool jumpPressed)
 {
     // Winning condition: survive for the specified time
-    if (hasElapsed(gameStartTime, RunnerGameConfig::WIN_TIME))
+    if (hasElapsed(gameStartTime, tuning.runnerWinTimeMs))
     {
         showWinScreen();
         return false; // Game is not complete yet, we're in the winning state
     }
 
-    // Update jump state
-    updateJumpState(currentTime, jumpPressed);
+    // Keep a press for the steps, however short it was and whenever it came
+    if (button.wasPressed())
+    {
+        jumpRequested = true;
+        jumpPressTime = button.pressTime();
+    }
 
-    // Update game speed
-    updateGameSpeed(currentTime);
+    if (collisionPending && collisionStands(currentTime))
+    {
+        showGameOver();
+        return false;
+    }
 
-    // Update game objects at fixed intervals
-    if (hasElapsed(lastUpdateTime, gameInterval))
+    uint8_t steps = 0;
+    while (currentTime - simTime >= gameInterval)
     {
-        lastUpdateTime = currentTime;
+        if (steps == RunnerGameConfig::MAX_CATCH_UP_STEPS)
+        {
+            simTime = currentTime; // Drop the backlog
+            break;
+        }
+        simTime += gameInterval;
+        steps++;
 
-        // Update game objects and check for collision
-        if (updateGameObjects())
+        if (stepSimulation(simTime, jumpPressed))
         {
             showGameOver();
             return false; // Game is not complete yet, player can restart
         }
-
-        // Draw game graphics
-        drawGameGraphics();
     }
 
+    render(currentTime);
+
     return false; // Game is not complete yet
 }
 
@@ -187,7 +397,7 @@ bool RunnerGame::handlePlayingState(unsigned long currentTime, bool jumpPressed)
  */
 bool RunnerGame::handleGameOverState(bool jumpPressed)
 {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = Clock::now();
 
     // Auto-restart after the specified delay
     if (hasElapsed(gameOverTime, RunnerGameConfig::RESTART_DELAY))
@@ -229,128 +439,440 @@ bool RunnerGame::handleWinningState(unsigned long currentTime)
 }
 
 /**
- * @brief Updates the jump state based on button input
+ * @brief Advances the simulation by one fixed step
  * 
- * Handles jump initiation and termination based on button presses and timing.
+ * Speed, jump and obstacles only ever see the step's simulated time, so the
+ * same inputs at the same steps give the same run.
  * 
- * @param currentTime Current time in milliseconds
+ * @param stepTime Simulated time of the step in milliseconds
  * @param jumpPressed Whether the jump button is currently pressed
+ * @return true if a collision is detected, false otherwise
  */
-void RunnerGame::updateJumpState(unsigned long currentTime, bool jumpPressed)
+bool RunnerGame::stepSimulation(unsigned long stepTime, bool jumpPressed)
 {
-    // Initiate jump only if not already jumping and the button has been released
-    if (!isJumping && jumpPressed && jumpButtonReleased)
+    if (collisionPending && collisionStands(stepTime))
+        return true;
+
+    updateGameSpeed(stepTime);
+    updateJumpState(stepTime, jumpPressed);
+    bool collided = updateGameObjects(stepTime);
+
+    // Hit on the ground: a press up to runnerCoyoteMs late still jumps
+    if (collided && !isJumping && tuning.runnerCoyoteMs > 0)
     {
-        isJumping = true;
-        jumpStartTime = currentTime;
-        llamaRow = RunnerGameConfig::JUMP_ROW;
-        jumpButtonReleased = false;
-        playJumpSound();
-        showJumpFeedback();
+        collisionPending = true;
+        collisionTime = stepTime;
+        collided = false;
     }
 
+    planScroll();
+    cellsDirty = true;
+    return collided;
+}
+
+/**
+ * @brief Settles a hit that a late press may still turn into a jump
+ * 
+ * A press that began within runnerCoyoteMs of the hit takes off as of the
+ * hit's step, as if it had been on time. runnerCoyoteMs is below the fastest
+ * tick, so the hit is settled before the obstacle moves on.
+ * 
+ * @param now Current or simulated time in milliseconds
+ * @return true once the hit stands and the game is over
+ */
+bool RunnerGame::collisionStands(unsigned long now)
+{
+    unsigned long deadline = collisionTime + tuning.runnerCoyoteMs;
+    if (jumpRequested && (long)(jumpPressTime - deadline) <= 0)
+    {
+        collisionPending = false;
+        jumpRequested = false;
+        startJump(collisionTime);
+        cellsDirty = true;
+        return false;
+    }
+    if ((long)(now - deadline) <= 0)
+        return false;
+
+    collisionPending = false;
+    return true;
+}
+
+/**
+ * @brief Takes off, the jump counts from the given time
+ * 
+ * @param stepTime Simulated time of the jump in milliseconds
+ */
+void RunnerGame::startJump(unsigned long stepTime)
+{
+    isJumping = true;
+    jumpStartTime = stepTime;
+    llamaRow = RunnerGameConfig::JUMP_ROW;
+#ifdef ENABLE_JUMP_LATENCY
+    latencyPending = true;
+    latencyPressTime = jumpPressTime;
+#endif
+    playJumpSound();
+    showJumpFeedback();
+}
+
+/**
+ * @brief Updates the jump state based on button input
+ * 
+ * Ends the jump after its maximum duration, or early once the button is
+ * released, then starts the requested one. A press on the ground fires on
+ * the next step. A press in the air is buffered and fires on landing if it
+ * began at most runnerJumpBufferMs before, otherwise it is dropped.
+ * 
+ * @param stepTime Simulated time of the step in milliseconds
+ * @param jumpPressed Whether the jump button is currently pressed
+ */
+void RunnerGame::updateJumpState(unsigned long stepTime, bool jumpPressed)
+{
     // Handle jump termination:
     // - Force end jump after maximum duration (JUMP_DURATION)
     // - Or if the button is released early (after a minimum jump time)
+    bool landed = false;
     if (isJumping)
     {
-        if (hasElapsed(jumpStartTime, RunnerGameConfig::JUMP_DURATION))
+        unsigned long airTime = stepTime - jumpStartTime;
+        if (airTime >= RunnerGameConfig::JUMP_DURATION)
         {
             // Maximum jump duration reached; force Llama to fall
-            isJumping = false;
-            llamaRow = RunnerGameConfig::GROUND_ROW;
+            landed = true;
         }
-        else if (!jumpPressed && hasElapsed(jumpStartTime, RunnerGameConfig::MIN_JUMP_DURATION))
+        else if (!jumpPressed && airTime >= RunnerGameConfig::MIN_JUMP_DURATION)
         {
             // Button released after a minimal jump duration; end jump early
+            landed = true;
+        }
+
+        if (landed)
+        {
             isJumping = false;
             llamaRow = RunnerGameConfig::GROUND_ROW;
         }
     }
+
+    if (!jumpRequested)
+        return;
+
+    bool stale = (long)(stepTime - jumpPressTime) > tuning.runnerJumpBufferMs;
+    if ((isJumping || landed) && stale)
+    {
+        jumpRequested = false;
+    }
+    else if (!isJumping)
+    {
+        jumpRequested = false;
+        startJump(stepTime);
+    }
 }
 
 /**
  * @brief Updates the game objects and checks for collisions
  * 
- * Moves the cactus, updates the animation state, and checks for collisions.
+ * Moves every obstacle one cell left, spawns the next one and updates the
+ * animation state. Movement and collision work on the lane masks, so a step
+ * costs the same however many obstacles are on screen.
  * 
+ * @param stepTime Simulated time of the step in milliseconds
  * @return true if a collision is detected, false otherwise
  */
-bool RunnerGame::updateGameObjects()
+bool RunnerGame::updateGameObjects(unsigned long stepTime)
 {
-    unsigned long currentTime = millis();
-
-    // Update cactus position
-    cactusPos--;
+    // Move every obstacle one cell left; an obstacle in column 0 leaves the screen
+    bool passed = false;
+    for (int row = 0; row < RunnerGameConfig::LCD_ROWS; row++)
+    {
+        passed |= (laneMask[row] & 1) != 0;
+        laneMask[row] >>= 1;
+    }
+    worldTick++;
 
     // Update animation state for running animation
-    if (!isJumping && hasElapsed(lastAnimationTime, RunnerGameConfig::ANIMATION_INTERVAL))
+    if (!isJumping && stepTime - lastAnimationTime >= RunnerGameConfig::ANIMATION_INTERVAL)
     {
-        lastAnimationTime = currentTime;
+        lastAnimationTime = stepTime;
         animationState = (animationState + 1) % RunnerGameConfig::ANIMATION_STATES;
     }
 
-    if (cactusPos < 0)
+    // Spawns are at least one cell apart, so at most one obstacle leaves per step
+    if (passed)
     {
-        cactusPos = RunnerGameConfig::INITIAL_CACTUS_POS;
+        obstacleHead = (obstacleHead + 1) & OBSTACLE_INDEX_MASK;
+        obstacleCount--;
         score++;
         playScoreSound();
         showScoreFeedback();
     }
 
-    if (cactusPos == 0 && llamaRow == RunnerGameConfig::GROUND_ROW)
+    if (--ticksToSpawn == 0)
     {
-        return true;
+        spawnObstacle();
     }
 
-    return false; // No collision
+    return (laneMask[llamaRow] & RunnerGameConfig::LLAMA_MASK) != 0;
 }
 
 /**
- * @brief Draws the game graphics on the LCD
+ * @brief Enters the next obstacle of the spawn pattern at the right edge
  * 
- * Renders the llama character and cactus obstacle based on their current positions and states.
+ * When a pattern is done, the next one is picked at random.
  */
-void RunnerGame::drawGameGraphics()
+void RunnerGame::spawnObstacle()
 {
-    lcd.clear();
+    if (patternStep >= PATTERNS[patternIndex].count)
+    {
+        patternIndex = random(PATTERN_COUNT);
+        patternStep = 0;
+    }
+    const SpawnStep &step = PATTERNS[patternIndex].steps[patternStep++];
 
-    lcd.setCursor(cactusPos, RunnerGameConfig::GROUND_ROW);
-    lcd.write(byte(RunnerGameConfig::CACTUS_PART1_ID));
-    lcd.setCursor(cactusPos + 1, RunnerGameConfig::GROUND_ROW);
-    lcd.write(byte(RunnerGameConfig::CACTUS_PART2_ID));
+    uint8_t gap = step.gapAfter * spawnGapPercent / 100;
+    ticksToSpawn = gap < RunnerGameConfig::MIN_OBSTACLE_GAP ? RunnerGameConfig::MIN_OBSTACLE_GAP : gap;
 
-    if (isJumping)
+    if (obstacleCount == RunnerGameConfig::MAX_OBSTACLES)
+        return;
+
+    RunnerObstacle &obstacle = obstacles[(obstacleHead + obstacleCount) & OBSTACLE_INDEX_MASK];
+    obstacle.type = step.type;
+    obstacle.spawnTick = worldTick;
+    obstacleCount++;
+    laneMask[obstacleRow(step.type)] |= 1U << RunnerGameConfig::OBSTACLE_SPAWN_COL;
+}
+
+/**
+ * @brief Forgets what CGRAM holds
+ * 
+ * Filling the cache with a pattern no glyph renders to makes the next
+ * syncGlyphs() upload every slot in use, e.g. after the LCD was initialised
+ * or another game used the slots.
+ */
+void RunnerGame::loadGlyphs()
+{
+    memset(cgram, 0xFF, sizeof(cgram));
+}
+
+/**
+ * @brief Picks the slots in use and the frames per cell for the next tick
+ * 
+ * Each frame uploads every changed glyph of the obstacle types on screen, and
+ * one upload takes about 11 ms on the 100 kHz I2C backpack. The frames per
+ * cell are cut until the uploads of a tick fit UPLOAD_BUDGET_PERMILLE of it,
+ * so the scrolling gets coarser instead of the game slowing down.
+ */
+void RunnerGame::planScroll()
+{
+    slotsInUse = LLAMA_SLOTS;
+    for (uint8_t i = 0; i < obstacleCount; i++)
     {
-        lcd.setCursor(0, llamaRow);
-        lcd.write(byte(RunnerGameConfig::LLAMA_STANDING_PART1_ID));
-        lcd.setCursor(1, llamaRow);
-        lcd.write(byte(RunnerGameConfig::LLAMA_STANDING_PART2_ID));
+        const RunnerObstacle &obstacle = obstacles[(obstacleHead + i) & OBSTACLE_INDEX_MASK];
+        slotsInUse |= slotsOf(OBSTACLE_CELLS[static_cast<uint8_t>(obstacle.type)]);
     }
-    else
+
+    uint32_t frameUs = __builtin_popcount(slotsInUse & ~LLAMA_SLOTS) * uploadUs;
+    uint32_t budgetUs = gameInterval * RunnerGameConfig::UPLOAD_BUDGET_PERMILLE;
+    uint32_t steps = frameUs == 0 ? RunnerGameConfig::MAX_SUB_STEPS : budgetUs / frameUs;
+    if (steps == 0)
+        steps = 1;
+    subSteps = steps > RunnerGameConfig::MAX_SUB_STEPS ? RunnerGameConfig::MAX_SUB_STEPS : (uint8_t)steps;
+
+    if (subSteps < frameStats.minSubSteps)
+        frameStats.minSubSteps = subSteps;
+}
+
+/**
+ * @brief Updates the LCD if something visible changed
+ * 
+ * The pixel position follows from the time since the last step, so a late
+ * frame skips pixels rather than falling behind. After a step the cells that
+ * changed are rewritten; between steps only the glyphs change, plus the lead
+ * cells that appear on the first shifted frame. Nothing is sent while the
+ * picture is unchanged, and never more often than RENDER_INTERVAL.
+ * 
+ * @param currentTime Current time in milliseconds
+ */
+void RunnerGame::render(unsigned long currentTime)
+{
+    uint32_t phase = (currentTime - simTime) * subSteps / gameInterval;
+    if (phase >= subSteps)
+        phase = subSteps - 1;
+    uint8_t shift = phase * RunnerGameConfig::CELL_PIXELS / subSteps;
+
+    if (!cellsDirty && shift == pixelShift)
+        return;
+    if (currentTime - lastRenderTime < RunnerGameConfig::RENDER_INTERVAL)
+        return;
+    lastRenderTime = currentTime;
+
+    bool leadCellsAppear = pixelShift == 0 && shift > 0;
+    pixelShift = shift;
+    syncGlyphs();
+
+    if (cellsDirty)
     {
-        lcd.setCursor(0, llamaRow);
-        if (animationState == 0)
-        {
-            lcd.write(byte(RunnerGameConfig::LLAMA_STANDING_PART1_ID));
-            lcd.setCursor(1, llamaRow);
-            lcd.write(byte(RunnerGameConfig::LLAMA_STANDING_PART2_ID));
-        }
-        else if (animationState == 1)
+        cellsDirty = false;
+        drawGameGraphics();
+#ifdef ENABLE_JUMP_LATENCY
+        if (latencyPending && llamaRow == RunnerGameConfig::JUMP_ROW)
         {
-            lcd.write(byte(RunnerGameConfig::LLAMA_RIGHT_FOOT_PART1_ID));
-            lcd.setCursor(1, llamaRow);
-            lcd.write(byte(RunnerGameConfig::LLAMA_RIGHT_FOOT_PART2_ID));
+            latencyPending = false;
+            jumpLatency.add(Clock::now() - latencyPressTime);
         }
-        else
+#endif
+    }
+    else if (leadCellsAppear)
+    {
+        Frame frame;
+        memcpy(frame, shownCells, sizeof(frame));
+        for (uint8_t i = 0; i < obstacleCount; i++)
+            drawObstacle(frame, obstacles[(obstacleHead + i) & OBSTACLE_INDEX_MASK], true);
+        showFrame(frame);
+    }
+}
+
+/**
+ * @brief Renders the glyphs for the current pixel shift and uploads the changed ones
+ * 
+ * The bird flaps on every step. Lead slots are not drawn while the obstacles
+ * sit on whole cells, so they are left stale then.
+ */
+void RunnerGame::syncGlyphs()
+{
+    uint8_t bitmaps[SLOT_COUNT][8];
+
+    GlyphId front = GlyphId::LlamaStandingPart1;
+    GlyphId back = GlyphId::LlamaStandingPart2;
+    if (!isJumping && animationState == 1)
+    {
+        front = GlyphId::LlamaRightFootPart1;
+        back = GlyphId::LlamaRightFootPart2;
+    }
+    else if (!isJumping && animationState == 2)
+    {
+        front = GlyphId::LlamaLeftFootPart1;
+        back = GlyphId::LlamaLeftFootPart2;
+    }
+    memcpy(bitmaps[SLOT_LLAMA_FRONT], Assets::glyph(front), 8);
+    memcpy(bitmaps[SLOT_LLAMA_BACK], Assets::glyph(back), 8);
+
+    const uint8_t *tall = Assets::glyph(GlyphId::CactusPart1);
+    const uint8_t *small = Assets::glyph(GlyphId::CactusPart2);
+    const uint8_t *bird = Assets::glyph((worldTick & 1) ? GlyphId::BirdWingsDown : GlyphId::BirdWingsUp);
+    shiftCell(bitmaps[SLOT_CACTUS_LEAD], nullptr, tall, pixelShift);
+    shiftCell(bitmaps[SLOT_CACTUS_MIDDLE], tall, small, pixelShift);
+    shiftCell(bitmaps[SLOT_CACTUS_TAIL], small, nullptr, pixelShift);
+    shiftCell(bitmaps[SLOT_SMALL_LEAD], nullptr, small, pixelShift);
+    shiftCell(bitmaps[SLOT_BIRD_LEAD], nullptr, bird, pixelShift);
+    shiftCell(bitmaps[SLOT_BIRD_TAIL], bird, nullptr, pixelShift);
+
+    uint8_t wanted = pixelShift == 0 ? slotsInUse & ~LEAD_SLOTS : slotsInUse;
+    uint8_t uploads = 0;
+    unsigned long start = micros();
+    for (uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+    {
+        if (!(wanted & (1 << slot)) || memcmp(cgram[slot], bitmaps[slot], 8) == 0)
+            continue;
+        memcpy(cgram[slot], bitmaps[slot], 8);
+        lcd.createChar(slot, cgram[slot]);
+        uploads++;
+    }
+    if (uploads == 0)
+        return;
+
+    uint32_t elapsedUs = micros() - start;
+    uploadUs = (uploadUs * 3 + elapsedUs / uploads) / 4;
+    frameStats.frames++;
+    frameStats.uploads += uploads;
+    if (elapsedUs > frameStats.maxFrameUs)
+        frameStats.maxFrameUs = elapsedUs;
+}
+
+/**
+ * @brief Puts the cells of one obstacle into a frame
+ * 
+ * Cells off screen are skipped. Lead cells never go into the llama's columns:
+ * the lead-only pass between steps does not redraw the llama.
+ * 
+ * @param frame    Frame to draw into
+ * @param obstacle Obstacle to draw
+ * @param leadOnly Only the cell it is scrolling into
+ */
+void RunnerGame::drawObstacle(Frame &frame, const RunnerObstacle &obstacle, bool leadOnly)
+{
+    const ObstacleCells &cells = OBSTACLE_CELLS[static_cast<uint8_t>(obstacle.type)];
+    int col = RunnerGameConfig::OBSTACLE_SPAWN_COL - (uint16_t)(worldTick - obstacle.spawnTick);
+    uint8_t *row = frame[obstacleRow(obstacle.type)];
+
+    if (pixelShift > 0 && col - 1 > 1 && col - 1 < RunnerGameConfig::LCD_COLS)
+        row[col - 1] = cells.lead;
+    if (leadOnly)
+        return;
+
+    if (col >= 0 && col < RunnerGameConfig::LCD_COLS)
+        row[col] = cells.body;
+    if (cells.tail != NO_SLOT && col + 1 >= 0 && col + 1 < RunnerGameConfig::LCD_COLS)
+        row[col + 1] = cells.tail;
+}
+
+/**
+ * @brief Draws the game graphics on the LCD
+ * 
+ * Composes every obstacle at its current cell and pixel shift, then the llama
+ * on top of them, and sends only the difference to the screen: the cells an
+ * obstacle or the llama left are blanked and the ones they moved into written.
+ */
+void RunnerGame::drawGameGraphics()
+{
+    Frame frame;
+    memset(frame, BLANK_CELL, sizeof(frame));
+
+    for (uint8_t i = 0; i < obstacleCount; i++)
+    {
+        drawObstacle(frame, obstacles[(obstacleHead + i) & OBSTACLE_INDEX_MASK], false);
+    }
+
+    frame[llamaRow][0] = SLOT_LLAMA_FRONT;
+    frame[llamaRow][1] = SLOT_LLAMA_BACK;
+
+    showFrame(frame);
+}
+
+/**
+ * @brief Sends the cells of a frame that differ from what the LCD shows
+ * 
+ * The LCD moves its cursor on after each write, so a run of changed cells
+ * needs a single setCursor().
+ * 
+ * @param frame Wanted content of every cell
+ */
+void RunnerGame::showFrame(const Frame &frame)
+{
+    for (uint8_t row = 0; row < RunnerGameConfig::LCD_ROWS; row++)
+    {
+        int cursor = -1;
+        for (uint8_t col = 0; col < RunnerGameConfig::LCD_COLS; col++)
         {
-            lcd.write(byte(RunnerGameConfig::LLAMA_LEFT_FOOT_PART1_ID));
-            lcd.setCursor(1, llamaRow);
-            lcd.write(byte(RunnerGameConfig::LLAMA_LEFT_FOOT_PART2_ID));
+            if (frame[row][col] == shownCells[row][col])
+                continue;
+            if (cursor != col)
+                lcd.setCursor(col, row);
+            lcd.write(frame[row][col]);
+            shownCells[row][col] = frame[row][col];
+            cursor = col + 1;
         }
     }
 }
 
+/**
+ * @brief Logs the glyph upload cost of the run
+ */
+void RunnerGame::reportFrameStats()
+{
+    LOG_INFO(RUNNER, RunnerFrameCost, frameStats.frames, frameStats.uploads, frameStats.maxFrameUs, frameStats.minSubSteps);
+}
+
 /**
  * @brief Plays the jump sound effect
  * 
@@ -384,64 +906,71 @@ void RunnerGame::playScoreSound()
 /**
  * @brief Shows visual feedback for jumping
  * 
- * Sets the RGB LED to the jump color for a short duration.
+ * Pulses the RGB LED in the jump color; the main loop's rgbLed.update() ends
+ * the pulse, so the game keeps running meanwhile.
  */
 void RunnerGame::showJumpFeedback()
 {
-    rgbLed.setColor(RunnerGameConfig::JUMP_LED_RED, RunnerGameConfig::JUMP_LED_GREEN, RunnerGameConfig::JUMP_LED_BLUE);
-    delay(RunnerGameConfig::LED_DURATION);
-    rgbLed.off();
+    rgbLed.pulse(RunnerGameConfig::JUMP_LED_RED, RunnerGameConfig::JUMP_LED_GREEN, RunnerGameConfig::JUMP_LED_BLUE,
+                 RunnerGameConfig::LED_DURATION);
 }
 
 /**
  * @brief Shows visual feedback for collision
  * 
- * Sets the RGB LED to the collision color for a short duration.
+ * Pulses the RGB LED in the collision color.
  */
 void RunnerGame::showCollisionFeedback()
 {
-    rgbLed.setColor(RunnerGameConfig::COLLISION_LED_RED, RunnerGameConfig::COLLISION_LED_GREEN, RunnerGameConfig::COLLISION_LED_BLUE);
-    delay(RunnerGameConfig::LED_DURATION);
-    rgbLed.off();
+    rgbLed.pulse(RunnerGameConfig::COLLISION_LED_RED, RunnerGameConfig::COLLISION_LED_GREEN, RunnerGameConfig::COLLISION_LED_BLUE,
+                 RunnerGameConfig::LED_DURATION);
 }
 
 /**
  * @brief Shows visual feedback for scoring
  * 
- * Sets the RGB LED to the score color for a short duration.
+ * Pulses the RGB LED in the score color.
  */
 void RunnerGame::showScoreFeedback()
 {
-    rgbLed.setColor(RunnerGameConfig::SCORE_LED_RED, RunnerGameConfig::SCORE_LED_GREEN, RunnerGameConfig::SCORE_LED_BLUE);
-    delay(RunnerGameConfig::LED_DURATION);
-    rgbLed.off();
+    rgbLed.pulse(RunnerGameConfig::SCORE_LED_RED, RunnerGameConfig::SCORE_LED_GREEN, RunnerGameConfig::SCORE_LED_BLUE,
+                 RunnerGameConfig::LED_DURATION);
 }
 
 /**
- * @brief Updates the game speed based on elapsed time
+ * @brief Updates the game speed and spawn density from the schedule
  * 
- * Gradually increases the game speed to make it more challenging.
+ * A table lookup by whole seconds into the run; the curve itself is built at
+ * compile time in RunnerSchedule.h.
  * 
- * @param currentTime Current time in milliseconds
+ * @param stepTime Simulated time of the step in milliseconds
  */
-void RunnerGame::updateGameSpeed(unsigned long currentTime)
+void RunnerGame::updateGameSpeed(unsigned long stepTime)
 {
-    // Check if it's time to increase the game speed
-    if (hasElapsed(lastSpeedIncreaseTime, RunnerGameConfig::SPEED_INCREASE_INTERVAL))
-    {
-        // Calculate new game interval (faster)
-        unsigned long newInterval = gameInterval * RunnerGameConfig::SPEED_INCREASE_FACTOR;
-
-        // Ensure we don't go below the minimum interval
-        if (newInterval >= RunnerGameConfig::MIN_GAME_INTERVAL)
-        {
-            gameInterval = newInterval;
-        }
+    const RunnerSchedule::Entry &entry = RunnerSchedule::at((stepTime - gameStartTime) / 1000);
+    speedLevel = entry.level;
+    gameInterval = levelIntervalMs[entry.level];
+    spawnGapPercent = entry.spawnGapPercent;
+}
 
-        // Update the last speed increase time
-        lastSpeedIncreaseTime = currentTime;
-    }
+#ifdef ENABLE_RUNNER_OBSERVER
+/**
+ * @brief Fills in a snapshot of the world, for test harnesses
+ */
+void RunnerGame::observe(RunnerView &view) const
+{
+    view.state = currentState;
+    view.laneMask[RunnerGameConfig::JUMP_ROW] = laneMask[RunnerGameConfig::JUMP_ROW];
+    view.laneMask[RunnerGameConfig::GROUND_ROW] = laneMask[RunnerGameConfig::GROUND_ROW];
+    view.obstacleCount = obstacleCount;
+    view.llamaRow = llamaRow;
+    view.isJumping = isJumping;
+    view.speedLevel = speedLevel;
+    view.gameInterval = gameInterval;
+    view.score = score;
+    view.gameStartTime = gameStartTime;
 }
+#endif
 
 /**
  * @brief Main game loop method
@@ -453,7 +982,9 @@ void RunnerGame::updateGameSpeed(unsigned long currentTime)
  */
 bool RunnerGame::run()
 {
-    unsigned long currentTime = millis();
+    PROFILE_ZONE(ProfileZone::RunnerRun);
+
+    unsigned long currentTime = Clock::now();
 
     // Update button state
     bool jumpPressed = button.read();
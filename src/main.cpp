@@ -1,11 +1,25 @@
 #include <Pins.h>
 #include <Arduino.h>
-#include <LiquidCrystal_I2C.h>
 
+#include "Lcd.h"
 #include "Buzzer.h"
 #include "RGBLed.h"
 #include "Whadda.h"
 #include "Button.h"
+#include "Benchmark.h"
+#include "Soak.h"
+#include "Profiler.h"
+#include "StallMonitor.h"
+#include "BinLog.h"
+#include "Tuning.h"
+#include "Checkpoint.h"
+#include "Console.h"
+#include "Telemetry.h"
+#include "HeapGuard.h"
+#include "MemStats.h"
+#include "BusStats.h"
+#include "Fmt.h"
+#include "Log.h"
 
 #include "ArcheryChallenge.h"
 #include "RunnerGame.h"
@@ -15,11 +29,11 @@
 // -----------------------------------------------------------------------------
 // Component Instances
 // -----------------------------------------------------------------------------
-LiquidCrystal_I2C lcd(0x27, 16, 2);
+Lcd lcd(0x27, 16, 2);
 RGBLed rgbLed(RGB_RED, RGB_GREEN, RGB_BLUE);
 Buzzer buzzer(BUZZER_PIN);
 Whadda whadda(STB_PIN, CLK_PIN, DIO_PIN);
-Button button(BTN_PIN, 25);
+Button<BTN_PIN> button(25);
 
 // -----------------------------------------------------------------------------
 // Global Variables for Game State
@@ -27,8 +41,23 @@ Button button(BTN_PIN, 25);
 bool showTimer = true;
 bool gameStarted = false;
 bool allChallengesComplete = false;
+bool sessionOver = false;                     // Won or timed out, only the console still runs
 unsigned long gameStartTime = 0;
-const unsigned long GAME_DURATION = 600000UL; // 10 minutes
+const unsigned long SERIAL_BAUD = 115200;     // Fast enough to drain the binary log
+unsigned long sessionSeed = 0;                // Seed of random(), settable from the console
+const long MAX_ADDTIME_SECONDS = 3600;         // addtime limit, the longest session tuning allows
+
+// -----------------------------------------------------------------------------
+// Challenges, played in order
+// -----------------------------------------------------------------------------
+RunnerGame runnerGame;
+MemoryGame memoryGame;
+EscapeVelocity escapeVelocity;
+ArcheryChallenge archeryChallenge;
+
+BaseGame *const challenges[] = {&runnerGame, &memoryGame, &escapeVelocity, &archeryChallenge};
+const int CHALLENGE_COUNT = sizeof(challenges) / sizeof(challenges[0]);
+int currentChallenge = 1; // 1-based, CHALLENGE_COUNT + 1 once all are done
 
 // -----------------------------------------------------------------------------
 // Function Declarations
@@ -40,6 +69,55 @@ void runChallenges();
 void handleGameOver();
 void handleGameWin();
 void handleChallengeCompletion(int& currentChallenge, int nextGameNumber);
+void serviceFinalScreen();
+bool resumeSession();
+void saveCheckpoint();
+unsigned long remainingTime();
+
+// -----------------------------------------------------------------------------
+// Operator console
+// -----------------------------------------------------------------------------
+void commandHelp(const Console::Args &args, Print &out);
+void commandStatus(const Console::Args &args, Print &out);
+void commandSkip(const Console::Args &args, Print &out);
+void commandAddTime(const Console::Args &args, Print &out);
+void commandReset(const Console::Args &args, Print &out);
+void commandStats(const Console::Args &args, Print &out);
+void commandSeed(const Console::Args &args, Print &out);
+void commandTune(const Console::Args &args, Print &out);
+void commandTelemetry(const Console::Args &args, Print &out);
+void commandMem(const Console::Args &args, Print &out);
+#ifdef ENABLE_STALL_MONITOR
+void commandStalls(const Console::Args &args, Print &out);
+#endif
+#ifdef ENABLE_PROFILER
+void commandProf(const Console::Args &args, Print &out);
+#endif
+#ifdef ENABLE_JUMP_LATENCY
+void commandLatency(const Console::Args &args, Print &out);
+#endif
+
+const Console::Command CONSOLE_COMMANDS[] = {
+    {"help", "", "list commands", commandHelp},
+    {"status", "", "session and challenge state", commandStatus},
+    {"skip", "", "finish the current challenge", commandSkip},
+    {"addtime", "<sec>", "add time to the clock, negative removes", commandAddTime},
+    {"reset", "<game>", "restart one challenge (1-4)", commandReset},
+    {"stats", "", "uptime, stall, log, heap, glyph and bus counters", commandStats},
+    {"seed", "[value]", "show or set the random seed", commandSeed},
+    {"tune", "[key value]", "list or set tuning parameters", commandTune},
+    {"telemetry", "[dump|clear]", "session records, dump is binary", commandTelemetry},
+    {"mem", "", "RAM breakdown and stack high-water mark", commandMem},
+#ifdef ENABLE_STALL_MONITOR
+    {"stalls", "", "list recent loop stalls", commandStalls},
+#endif
+#ifdef ENABLE_PROFILER
+    {"prof", "[reset]", "print or clear the profiler table", commandProf},
+#endif
+#ifdef ENABLE_JUMP_LATENCY
+    {"latency", "[reset]", "runner jump press-to-screen histogram", commandLatency},
+#endif
+};
 
 /**
  * @brief Setup function
@@ -50,41 +128,98 @@ void handleChallengeCompletion(int& currentChallenge, int nextGameNumber);
  */
 void setup()
 {
-  Serial.begin(9600);
+  MemStats::begin();
+  Serial.begin(SERIAL_BAUD);
   Serial.println("Initializing...");
 
+#ifdef ENABLE_PROFILER
+  Profiler::begin();
+#endif
+  StallMonitor::begin();
+  Console::begin(CONSOLE_COMMANDS, sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]));
+  Assets::begin();
+  Tuning::load();
+  Telemetry::begin();
+
   // Initialize Whadda display
   whadda.displayBegin();
   whadda.clearDisplay();
-  whadda.displayText("Escape Room!");
+  whadda.displayText(StringId::EscapeRoom);
 
   // Initialize LCD
   lcd.init();
   lcd.backlight();
   lcd.clear();
-  lcd.print("Escape Room!");
-
-  // Create custom characters for Runner Game
-  lcd.createChar(RunnerGameConfig::LLAMA_STANDING_PART1_ID, RunnerGameConfig::llamaStandingPart1);
-  lcd.createChar(RunnerGameConfig::LLAMA_STANDING_PART2_ID, RunnerGameConfig::llamaStandingPart2);
-  lcd.createChar(RunnerGameConfig::LLAMA_RIGHT_FOOT_PART1_ID, RunnerGameConfig::llamaRightFootPart1);
-  lcd.createChar(RunnerGameConfig::LLAMA_RIGHT_FOOT_PART2_ID, RunnerGameConfig::llamaRightFootPart2);
-  lcd.createChar(RunnerGameConfig::LLAMA_LEFT_FOOT_PART1_ID, RunnerGameConfig::llamaLeftFootPart1);
-  lcd.createChar(RunnerGameConfig::LLAMA_LEFT_FOOT_PART2_ID, RunnerGameConfig::llamaLeftFootPart2);
-  lcd.createChar(RunnerGameConfig::CACTUS_PART1_ID, RunnerGameConfig::cactusPart1);
-  lcd.createChar(RunnerGameConfig::CACTUS_PART2_ID, RunnerGameConfig::cactusPart2);
+  lcd.print(StringId::EscapeRoom);
 
   // Initialize start button
   pinMode(BTN_PIN, INPUT_PULLUP);
-  randomSeed(analogRead(POT_PIN));
+  sessionSeed = analogRead(POT_PIN);
+  randomSeed(sessionSeed);
 
   // Initialize Buzzer and RGB LED
   buzzer.begin();
   rgbLed.begin();
 
-  // Prompt user to press the start button
-  lcd.setCursor(0, 1);
-  lcd.print("Press start btn");
+#ifdef BENCHMARK
+  // Bench builds measure every game once before handing over to the normal flow
+  Benchmark::runAll();
+#endif
+#ifdef SOAK
+  // Soak builds play the Runner Game unattended on the virtual clock first
+  Soak::run();
+#endif
+
+  // Continue an interrupted session, otherwise prompt user to press the start button
+  if (!resumeSession())
+  {
+    lcd.setCursor(0, 1);
+    lcd.print(StringId::PressStart);
+  }
+
+  // Everything the core allocates (Wire buffers, PWM and tone timers) exists by now
+  HeapGuard::lock();
+}
+
+/**
+ * @brief Picks up the session that was running when the board reset.
+ *
+ * Restores the challenge, its progress and the clock from the last
+ * checkpoint and skips the start prompt.
+ *
+ * @return true if a session was resumed.
+ */
+bool resumeSession()
+{
+  Checkpoint::Session session;
+  if (!Checkpoint::restore(session) || session.challenge < 1 || session.challenge > CHALLENGE_COUNT)
+    return false;
+
+  currentChallenge = session.challenge;
+  challenges[currentChallenge - 1]->resumeFrom(session.progress);
+  gameStartTime = millis() - session.elapsedMs;
+  gameStarted = true;
+  Telemetry::beginSession(currentChallenge, true);
+
+  lcd.clear();
+  showTimer = false;
+  lcd.print(StringId::Resuming);
+  return true;
+}
+
+/**
+ * @brief Saves the running session so a reset can resume it.
+ *
+ * Called when a session starts, when the challenge changes, and when the
+ * running challenge asks for it between two timed actions, never on every loop.
+ */
+void saveCheckpoint()
+{
+  Checkpoint::Session session;
+  session.challenge = currentChallenge;
+  session.progress = challenges[currentChallenge - 1]->getProgress();
+  session.elapsedMs = millis() - gameStartTime;
+  Checkpoint::save(session);
 }
 
 /**
@@ -98,6 +233,13 @@ void setup()
  */
 void loop()
 {
+  PROFILE_ZONE(ProfileZone::Loop);
+  StallMonitor::beginTick();
+
+  Console::poll(Serial);
+  MemStats::poll();
+  BinLog::drain();
+
   // Update hardware interfaces
   rgbLed.update();
   whadda.update();
@@ -120,6 +262,8 @@ void loop()
 
     // Run the current challenge
     runChallenges();
+    if (challenges[currentChallenge - 1]->takeCheckpointRequest())
+      saveCheckpoint();
 
     // If all challenges are complete, handle the win condition
     if (allChallengesComplete)
@@ -127,6 +271,10 @@ void loop()
       handleGameWin();
     }
   }
+
+  uint8_t activeGame = gameStarted ? currentChallenge : 0;
+  uint8_t activeState = (activeGame >= 1 && activeGame <= CHALLENGE_COUNT) ? challenges[activeGame - 1]->getStateCode() : 0;
+  StallMonitor::endTick(activeGame, activeState);
 }
 
 /**
@@ -144,9 +292,11 @@ void checkGameStart()
   {
     gameStarted = true;
     gameStartTime = millis(); // Record start time
+    Telemetry::beginSession(currentChallenge, false);
+    saveCheckpoint();
     lcd.clear();
     showTimer = false;
-    lcd.print("Game Started!");
+    lcd.print(StringId::GameStarted);
   }
 
   prevButtonState = currentState;
@@ -156,23 +306,43 @@ void checkGameStart()
  * @brief Updates the countdown timer on the LCD.
  *
  * Formats the remaining time (MM:SS) and displays it at a fixed position.
+ * It is only sent when the shown second changes, when the timer comes back
+ * on, or after the screen was cleared: each write costs about a millisecond
+ * on the I2C bus.
  */
 void updateTimerOnLCD()
 {
+  PROFILE_ZONE(ProfileZone::TimerLcd);
+
+  static bool timerShown = false;
+  static unsigned long shownSeconds = 0;
+  static uint16_t shownClears = 0;
+
   if (!showTimer)
+  {
+    timerShown = false;
     return;
+  }
 
-  unsigned long elapsed = millis() - gameStartTime;
-  unsigned long remaining = (elapsed < GAME_DURATION) ? (GAME_DURATION - elapsed) : 0;
-
-  // Convert remaining time to minutes and seconds
-  unsigned int seconds = (remaining / 1000UL) % 60;
-  unsigned int minutes = (remaining / 1000UL) / 60;
+  unsigned long seconds = remainingTime() / 1000UL;
+  if (timerShown && seconds == shownSeconds && lcd.clears() == shownClears)
+    return;
+  timerShown = true;
+  shownSeconds = seconds;
+  shownClears = lcd.clears();
 
   lcd.setCursor(11, 0);
-  char timerStr[6]; // Format: MM:SS
-  snprintf(timerStr, sizeof(timerStr), "%02u:%02u", minutes, seconds);
-  lcd.print(timerStr);
+  lcd.print(Fmt::minutesSeconds(seconds).text);
+}
+
+/**
+ * @brief Time left on the clock in milliseconds.
+ */
+unsigned long remainingTime()
+{
+  unsigned long elapsed = millis() - gameStartTime;
+  unsigned long gameDuration = tuning.gameDurationMs;
+  return (elapsed < gameDuration) ? (gameDuration - elapsed) : 0;
 }
 
 /**
@@ -181,7 +351,7 @@ void updateTimerOnLCD()
 bool timeRemaining()
 {
   unsigned long elapsed = millis() - gameStartTime;
-  return (elapsed < GAME_DURATION);
+  return (elapsed < (unsigned long)tuning.gameDurationMs);
 }
 
 /**
@@ -192,92 +362,52 @@ bool timeRemaining()
  */
 void handleChallengeCompletion(int& currentChallenge, int nextGameNumber) {
   currentChallenge++;
+  Telemetry::enterChallenge(currentChallenge);
   lcd.clear();
   showTimer = false;
-  lcd.print("Game ");
-  lcd.print(nextGameNumber);
-  lcd.print(" start");
+  lcd.print(StringId::GamePrefix);
+  lcd.print(Fmt::unsignedField<1>(nextGameNumber).text);
+  lcd.print(StringId::StartSuffix);
+  saveCheckpoint();
 }
 
 /**
  * @brief Runs challenges sequentially.
  *
- * Uses a static challenge counter to decide which challenge to run.
+ * Uses the challenge counter to decide which challenge to run.
  * Each challenge is non-blocking; when a challenge is finished, the counter is incremented.
  */
 void runChallenges()
 {
-  static int currentChallenge = 1;
-  bool challengeFinished = false;
-
-  switch (currentChallenge)
+  if (currentChallenge > CHALLENGE_COUNT)
   {
-  case 1:
-  {
-    static RunnerGame runnerGame;
-    challengeFinished = runnerGame.run();
-     //static ArcheryChallenge archeryChallenge;
-     //challengeFinished = archeryChallenge.run();
-     // static MemoryGame memoryGame;
-     // challengeFinished = memoryGame.run();
-     // static EscapeVelocity escapeVelocity;
-     // challengeFinished = escapeVelocity.run();
-     if (challengeFinished)
-     {
-      handleChallengeCompletion(currentChallenge, 2);
-    }
-  }
-  break;
-
-  case 2:
-  {
-    static MemoryGame memoryGame;
-    challengeFinished = memoryGame.run();
-    if (challengeFinished)
+    // No further challenges
+    lcd.clear();
+    lcd.setCursor(0, 0);
+    lcd.print(StringId::AllDoneLine1);
+    lcd.setCursor(0, 1);
+    lcd.print(StringId::AllDoneLine2);
+    sessionOver = true;
+    while (1)
     {
-      handleChallengeCompletion(currentChallenge, 3);
+      serviceFinalScreen();
+      rgbLed.setColor(0, 255, 0);
+      rgbLed.blinkCurrentColor(1);
     }
   }
-  break;
 
-  case 3:
+  bool challengeFinished = challenges[currentChallenge - 1]->run();
+  if (challengeFinished)
   {
-    static EscapeVelocity escapeVelocity;
-    challengeFinished = escapeVelocity.run();
-
-    if (challengeFinished)
+    if (currentChallenge < CHALLENGE_COUNT)
     {
-      handleChallengeCompletion(currentChallenge, 4);
+      handleChallengeCompletion(currentChallenge, currentChallenge + 1);
     }
-  }
-  break;
-
-  case 4:
-  {
-    static ArcheryChallenge archeryChallenge;
-    challengeFinished = archeryChallenge.run();
-
-    if (challengeFinished)
+    else
     {
       allChallengesComplete = true;
     }
   }
-  break;
-
-  default:
-    // No further challenges
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print("Game Over");
-    lcd.setCursor(0, 1);
-    lcd.print("You Won...");
-    while (1)
-    {
-      rgbLed.setColor(0, 255, 0);
-      rgbLed.blinkCurrentColor(1);
-    }
-    break;
-  }
 }
 
 /**
@@ -287,12 +417,16 @@ void runChallenges()
  */
 void handleGameWin()
 {
-  buzzer.playWinMelody();
+  Checkpoint::clear();
+  Telemetry::endSession(Telemetry::Outcome::Win);
+  buzzer.playMelody(MelodyId::Win);
   lcd.clear();
-  lcd.print("You Escaped!");
-  buzzer.playImperialMarch(1);
+  lcd.print(StringId::Escaped);
+  buzzer.playMelody(MelodyId::ImperialMarch);
+  sessionOver = true;
   while (1)
   {
+    serviceFinalScreen();
     // Example win effect: set LEDs to green and blink them
     rgbLed.setColor(0, 255, 0);
     rgbLed.blinkCurrentColor(3);
@@ -306,12 +440,333 @@ void handleGameWin()
  */
 void handleGameOver()
 {
-  buzzer.playLoseMelody();
+  Checkpoint::clear();
+  Telemetry::endSession(Telemetry::Outcome::TimeOut);
+  buzzer.playMelody(MelodyId::Lose);
   lcd.clear();
   showTimer = false;
-  lcd.print("Game Over!");
+  lcd.print(StringId::GameOver);
+  sessionOver = true;
   while (1)
   {
     // Remain in the game-over state
+    serviceFinalScreen();
+  }
+}
+
+/**
+ * @brief Keeps the console, the binary log and the watchdog going on the final screens.
+ *
+ * The win, game-over and all-done screens loop forever and never get back to
+ * loop(), so they call this instead.
+ */
+void serviceFinalScreen()
+{
+  Console::poll(Serial);
+  BinLog::drain();
+  StallMonitor::idle();
+}
+
+/**
+ * @brief Console: lists the commands.
+ */
+void commandHelp(const Console::Args &, Print &out)
+{
+  Console::printHelp(out);
+}
+
+/**
+ * @brief Console: prints the session clock and the current challenge.
+ */
+void commandStatus(const Console::Args &, Print &out)
+{
+  if (!gameStarted)
+  {
+    out.println("waiting for start");
+    return;
+  }
+  if (sessionOver)
+  {
+    out.println(allChallengesComplete ? "session over, escaped" : "session over, time ran out");
+    return;
+  }
+
+  unsigned long remaining = remainingTime() / 1000UL;
+  out.print("game ");
+  out.print(currentChallenge);
+  out.print('/');
+  out.print(CHALLENGE_COUNT);
+  if (allChallengesComplete)
+    out.print(" (all done)");
+  out.print(", state ");
+  out.print(challenges[currentChallenge - 1]->getStateCode());
+  out.print(", progress ");
+  out.print(challenges[currentChallenge - 1]->getProgress());
+  out.print(", ");
+  out.print(remaining / 60);
+  out.print(remaining % 60 < 10 ? ":0" : ":");
+  out.print(remaining % 60);
+  out.println(" left");
+}
+
+/**
+ * @brief Console: ends the current challenge as if it had been won.
+ */
+void commandSkip(const Console::Args &, Print &out)
+{
+  if (!gameStarted || allChallengesComplete || sessionOver)
+  {
+    out.println("no challenge running");
+    return;
+  }
+
+  LOG_INFO(SYSTEM, ConsoleSkip, currentChallenge);
+  challenges[currentChallenge - 1]->reset();
+  if (currentChallenge < CHALLENGE_COUNT)
+  {
+    handleChallengeCompletion(currentChallenge, currentChallenge + 1);
+  }
+  else
+  {
+    allChallengesComplete = true;
+  }
+  out.println("skipped");
+}
+
+/**
+ * @brief Console: moves the session clock.
+ *
+ * Positive values give the players more time, up to the full game duration;
+ * negative values take time away. Either way by at most MAX_ADDTIME_SECONDS.
+ */
+void commandAddTime(const Console::Args &args, Print &out)
+{
+  long seconds;
+  if (!args.toInt(1, seconds))
+  {
+    out.println("usage: addtime <sec>");
+    return;
+  }
+  if (seconds > MAX_ADDTIME_SECONDS || seconds < -MAX_ADDTIME_SECONDS)
+  {
+    out.print("at most ");
+    out.print(MAX_ADDTIME_SECONDS);
+    out.println(" s either way");
+    return;
+  }
+  if (!gameStarted || sessionOver)
+  {
+    out.println("no session running");
+    return;
+  }
+
+  // Keep gameStartTime in the past, millis() - gameStartTime must not wrap
+  unsigned long now = millis();
+  unsigned long elapsed = now - gameStartTime;
+  long deltaMs = seconds * 1000L;
+  if (deltaMs > 0 && (unsigned long)deltaMs > elapsed)
+    elapsed = 0;
+  else
+    elapsed -= deltaMs;
+  gameStartTime = now - elapsed;
+
+  LOG_INFO(SYSTEM, ConsoleAddTime, seconds);
+  out.print(remainingTime() / 1000UL);
+  out.println(" s left");
+}
+
+/**
+ * @brief Console: restarts one challenge from its intro.
+ */
+void commandReset(const Console::Args &args, Print &out)
+{
+  long game;
+  if (!args.toInt(1, game) || game < 1 || game > CHALLENGE_COUNT)
+  {
+    out.println("usage: reset <game>, game is 1-4");
+    return;
+  }
+
+  LOG_INFO(SYSTEM, ConsoleReset, game);
+  challenges[game - 1]->reset();
+  if (gameStarted && !allChallengesComplete && !sessionOver && game == currentChallenge)
+  {
+    lcd.clear();
+    showTimer = false;
+    lcd.print(StringId::GamePrefix);
+    lcd.print(Fmt::unsignedField<1>(game).text);
+    lcd.print(StringId::StartSuffix);
+  }
+  out.println("reset");
+}
+
+/**
+ * @brief Console: prints the diagnostic counters.
+ */
+void commandStats(const Console::Args &, Print &out)
+{
+  out.print("uptime ");
+  out.print(millis() / 1000UL);
+  out.print(" s, loop stalls ");
+  out.print(StallMonitor::stallCount());
+  out.print(", log records dropped ");
+  out.println(BinLog::droppedCount());
+  HeapGuard::print(out);
+  const RunnerFrameStats &frames = runnerGame.getFrameStats();
+  out.print("runner glyphs: ");
+  out.print(frames.frames);
+  out.print(" frames, ");
+  out.print(frames.uploads);
+  out.print(" uploads, slowest ");
+  out.print(frames.maxFrameUs);
+  out.print(" us, min ");
+  out.print(frames.minSubSteps);
+  out.println(" frames/cell");
+#ifdef ENABLE_BUS_STATS
+  out.print("i2c ");
+  out.print(BusStats::counters.i2cBytes);
+  out.print(" B, tm1638 ");
+  out.print(BusStats::counters.tm1638Transactions);
+  out.print(" transfers, tone ");
+  out.print(BusStats::counters.toneCalls);
+  out.print(" calls, delay ");
+  out.print(BusStats::counters.delayMs);
+  out.println(" ms");
+#endif
+}
+
+/**
+ * @brief Console: shows or sets the seed of random().
+ *
+ * Setting a seed makes the next generated sequences and targets repeatable.
+ */
+void commandSeed(const Console::Args &args, Print &out)
+{
+  long seed;
+  if (args.toInt(1, seed))
+  {
+    sessionSeed = (unsigned long)seed;
+    randomSeed(sessionSeed);
+  }
+  else if (args.count > 1)
+  {
+    out.println("usage: seed [value]");
+    return;
+  }
+  out.print("seed ");
+  out.println(sessionSeed);
+}
+
+/**
+ * @brief Console: lists the tuning parameters or changes one.
+ */
+void commandTune(const Console::Args &args, Print &out)
+{
+  if (args.count == 1)
+  {
+    Tuning::print(out);
+    return;
+  }
+
+  long key;
+  long value;
+  if (!args.toInt(1, key) || !args.toInt(2, value) || key < 0 || key > 0xFFFF)
+  {
+    out.println("usage: tune [key value]");
+    return;
+  }
+  switch (Tuning::set(static_cast<TuningKey>(key), value))
+  {
+  case Tuning::SetResult::Saved:
+    out.println("saved");
+    break;
+  case Tuning::SetResult::Invalid:
+    out.println("rejected: unknown key or value out of range");
+    break;
+  case Tuning::SetResult::StoreFailed:
+    out.println("not saved: config store write failed, value unchanged");
+    break;
+  }
+}
+
+/**
+ * @brief Console: prints the RAM breakdown and the heap counters.
+ */
+void commandMem(const Console::Args &, Print &out)
+{
+  MemStats::print(out);
+  HeapGuard::print(out);
+}
+
+/**
+ * @brief Console: summarises, exports or erases the session telemetry.
+ *
+ * Dump and clear block for a while, so they are refused during a session.
+ */
+void commandTelemetry(const Console::Args &args, Print &out)
+{
+  if (args.count == 1)
+  {
+    Telemetry::printSummary(out);
+    return;
+  }
+  if (gameStarted && !sessionOver)
+  {
+    out.println("not during a session");
+    return;
+  }
+
+  if (strcmp(args.values[1], "dump") == 0)
+    Telemetry::exportRecords(out);
+  else if (strcmp(args.values[1], "clear") == 0)
+    out.println(Telemetry::clear() ? "telemetry cleared" : "erase failed");
+  else
+    out.println("usage: telemetry [dump|clear]");
+}
+
+#ifdef ENABLE_STALL_MONITOR
+/**
+ * @brief Console: lists the recent loop stalls.
+ */
+void commandStalls(const Console::Args &, Print &out)
+{
+  StallMonitor::dump(out);
+}
+#endif
+
+#ifdef ENABLE_PROFILER
+/**
+ * @brief Console: prints the profiler table, or clears it with "prof reset".
+ */
+void commandProf(const Console::Args &args, Print &out)
+{
+  if (args.count > 1 && strcmp(args.values[1], "reset") == 0)
+  {
+    Profiler::reset();
+    out.println("profiler cleared");
+    return;
+  }
+  Profiler::dump(out);
+}
+#endif
+
+#ifdef ENABLE_JUMP_LATENCY
+/**
+ * @brief Console: prints or clears the Runner jump latency histogram.
+ *
+ * Bucket n counts jumps drawn 2^n to 2^(n+1) ms after the press began.
+ */
+void commandLatency(const Console::Args &args, Print &out)
+{
+  Log2Histogram &latency = runnerGame.getJumpLatency();
+  if (args.count > 1 && strcmp(args.values[1], "reset") == 0)
+  {
+    latency = Log2Histogram{};
+    out.println("latency cleared");
+    return;
   }
+  out.print("jump press to screen, log2 ms:");
+  latency.print(out);
+  out.println();
 }
+#endif
@@ -0,0 +1,217 @@
+#include "AssetPack.h"
+#include "Crc32.h"
+#include "Log.h"
+
+namespace
+{
+    // Names of the StringId entries, one per line, must hash to Header::schema
+    constexpr char STRING_SCHEMA[] =
+#define ASSET_STRING(id, text) #id "\n"
+#include "AssetStrings.def"
+#undef ASSET_STRING
+        ;
+
+    constexpr uint32_t SCHEMA = Crc32::compute(STRING_SCHEMA, sizeof(STRING_SCHEMA) - 1);
+
+    AssetPack::Status packStatus = AssetPack::Status::Missing;
+    uint32_t packVersion = 0;
+
+    // Section views into flash, count 0 when the section is absent
+    const uint16_t *stringOffsets = nullptr;
+    const char *stringData = nullptr;
+    uint16_t stringCount = 0;
+
+    const uint8_t *glyphData = nullptr;
+    uint16_t glyphCount = 0;
+
+    const AssetPack::MelodyEntry *melodyEntries = nullptr;
+    const Note *notes = nullptr;
+    uint16_t melodyCount = 0;
+
+    const AssetPack::TuningEntry *tuningEntries = nullptr;
+    uint16_t tuningCount = 0;
+
+    void unmount()
+    {
+        packVersion = 0;
+        stringCount = glyphCount = melodyCount = tuningCount = 0;
+    }
+
+    /**
+     * @brief Checks one section's size against its entry count and hooks it up.
+     */
+    bool mountSection(const uint8_t *base, const AssetPack::SectionEntry &entry)
+    {
+        const uint8_t *data = base + entry.offset;
+
+        switch (static_cast<AssetPack::SectionType>(entry.type))
+        {
+        case AssetPack::SectionType::Strings:
+        {
+            // The section ends with a terminator, so every offset inside it is a valid string
+            if (entry.size < entry.count * sizeof(uint16_t) + 1 || data[entry.size - 1] != '\0')
+                return false;
+            const uint16_t *offsets = reinterpret_cast<const uint16_t *>(data);
+            for (uint16_t i = 0; i < entry.count; i++)
+            {
+                if (offsets[i] < entry.count * sizeof(uint16_t) || offsets[i] >= entry.size)
+                    return false;
+            }
+            stringOffsets = offsets;
+            stringData = reinterpret_cast<const char *>(data);
+            stringCount = entry.count;
+            return true;
+        }
+        case AssetPack::SectionType::Glyphs:
+            if (entry.size != entry.count * 8UL)
+                return false;
+            glyphData = data;
+            glyphCount = entry.count;
+            return true;
+
+        case AssetPack::SectionType::Melodies:
+        {
+            uint32_t tableSize = entry.count * sizeof(AssetPack::MelodyEntry);
+            if (entry.size < tableSize || (entry.size - tableSize) % sizeof(Note) != 0)
+                return false;
+            uint32_t noteCount = (entry.size - tableSize) / sizeof(Note);
+            const AssetPack::MelodyEntry *entries = reinterpret_cast<const AssetPack::MelodyEntry *>(data);
+            for (uint16_t i = 0; i < entry.count; i++)
+            {
+                if (entries[i].firstNote + entries[i].length > noteCount)
+                    return false;
+            }
+            melodyEntries = entries;
+            notes = reinterpret_cast<const Note *>(data + tableSize);
+            melodyCount = entry.count;
+            return true;
+        }
+        case AssetPack::SectionType::Tuning:
+            if (entry.size != entry.count * sizeof(AssetPack::TuningEntry))
+                return false;
+            tuningEntries = reinterpret_cast<const AssetPack::TuningEntry *>(data);
+            tuningCount = entry.count;
+            return true;
+
+        default:
+            return true; // Section from a newer tool, skip it
+        }
+    }
+
+    AssetPack::Status validate(const uint8_t *base)
+    {
+        const AssetPack::Header &header = *reinterpret_cast<const AssetPack::Header *>(base);
+
+        if (header.magic == 0xFFFFFFFF)
+            return AssetPack::Status::Missing;
+
+        uint32_t indexEnd = sizeof(AssetPack::Header) + header.sectionCount * sizeof(AssetPack::SectionEntry);
+        if (header.magic != AssetPack::MAGIC || header.formatVersion != AssetPack::FORMAT_VERSION ||
+            header.totalSize > FlashLayout::ASSET_PACK_SIZE || header.totalSize < indexEnd)
+            return AssetPack::Status::BadHeader;
+
+        if (Crc32::compute(base + 8, header.totalSize - 8) != header.crc)
+            return AssetPack::Status::BadCrc;
+
+        if (header.schema != SCHEMA)
+            return AssetPack::Status::SchemaMismatch;
+
+        const AssetPack::SectionEntry *index = reinterpret_cast<const AssetPack::SectionEntry *>(base + sizeof(AssetPack::Header));
+        for (uint16_t i = 0; i < header.sectionCount; i++)
+        {
+            const AssetPack::SectionEntry &entry = index[i];
+            if (entry.offset % 4 != 0 || entry.offset < indexEnd || entry.offset > header.totalSize ||
+                entry.size > header.totalSize - entry.offset || !mountSection(base, entry))
+                return AssetPack::Status::BadIndex;
+        }
+
+        packVersion = header.packVersion;
+        return AssetPack::Status::Mounted;
+    }
+}
+
+/**
+ * @brief Validates the pack and makes its sections available.
+ *
+ * Reads about 16 KB of flash for the CRC, only call it at boot.
+ *
+ * @param base Start of the pack, the reserved flash region by default.
+ * @return Status::Mounted if the pack is used.
+ */
+AssetPack::Status AssetPack::mount(const uint8_t *base)
+{
+    unmount();
+    packStatus = validate(base);
+    if (packStatus != Status::Mounted)
+        unmount();
+
+    if (packStatus == Status::Mounted)
+        LOG_INFO(SYSTEM, AssetPackMounted, packVersion, reinterpret_cast<const Header *>(base)->totalSize);
+    else if (packStatus != Status::Missing)
+        LOG_WARN(SYSTEM, AssetPackRejected, static_cast<uint8_t>(packStatus));
+
+    return packStatus;
+}
+
+/**
+ * @brief Result of the last mount().
+ */
+AssetPack::Status AssetPack::status()
+{
+    return packStatus;
+}
+
+/**
+ * @brief Content version of the mounted pack, 0 if none.
+ */
+uint32_t AssetPack::version()
+{
+    return packVersion;
+}
+
+/**
+ * @brief Text of a string entry, nullptr if the pack does not have it.
+ */
+const char *AssetPack::string(uint8_t index)
+{
+    return index < stringCount ? stringData + stringOffsets[index] : nullptr;
+}
+
+/**
+ * @brief Bitmap of a glyph entry, nullptr if the pack does not have it.
+ */
+const uint8_t *AssetPack::glyph(uint8_t index)
+{
+    return index < glyphCount ? glyphData + index * 8 : nullptr;
+}
+
+/**
+ * @brief Fills in a melody entry, false if the pack does not have it.
+ */
+bool AssetPack::melody(uint8_t index, Melody &melody)
+{
+    if (index >= melodyCount)
+        return false;
+
+    const MelodyEntry &entry = melodyEntries[index];
+    melody.notes = notes + entry.firstNote;
+    melody.length = entry.length;
+    melody.pauseMs = entry.pauseMs;
+    return true;
+}
+
+/**
+ * @brief Looks up a tuning value by key, false if the pack does not have it.
+ */
+bool AssetPack::tuning(uint16_t key, int32_t &value)
+{
+    for (uint16_t i = 0; i < tuningCount; i++)
+    {
+        if (tuningEntries[i].key == key)
+        {
+            value = tuningEntries[i].value;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,146 @@
+#include "Assets.h"
+#include "AssetPack.h"
+
+namespace
+{
+    const char *const STRINGS[] = {
+#define ASSET_STRING(id, text) text,
+#include "AssetStrings.def"
+#undef ASSET_STRING
+    };
+
+    static_assert(sizeof(STRINGS) / sizeof(STRINGS[0]) == static_cast<size_t>(StringId::Count), "String table out of sync");
+
+    const uint8_t GLYPHS[][8] = {
+        // LlamaStandingPart1: not moving or jumping
+        {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00011},
+        // LlamaStandingPart2
+        {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B11000},
+        // LlamaRightFootPart1: running animation
+        {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00011},
+        // LlamaRightFootPart2
+        {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B00000},
+        // LlamaLeftFootPart1: running animation
+        {B00000, B00000, B00110, B00110, B00111, B00111, B00011, B00000},
+        // LlamaLeftFootPart2
+        {B00111, B00111, B00111, B00100, B11100, B11100, B11000, B11000},
+        // CactusPart1
+        {B00000, B00100, B00100, B10100, B10100, B11100, B00100, B00100},
+        // CactusPart2
+        {B00100, B00101, B00101, B10101, B11111, B00100, B00100, B00100},
+        // BirdWingsUp: one cell, alternates with BirdWingsDown while flying
+        {B00000, B10001, B01010, B00100, B01110, B00000, B00000, B00000},
+        // BirdWingsDown
+        {B00000, B00000, B00000, B00100, B01110, B01010, B10001, B00000},
+    };
+
+    static_assert(sizeof(GLYPHS) / sizeof(GLYPHS[0]) == static_cast<size_t>(GlyphId::Count), "Glyph table out of sync");
+
+    const Note WIN_NOTES[] = {
+        {523, 150, 160},  // C5
+        {659, 150, 160},  // E5
+        {783, 200, 210},  // G5
+        {1046, 300, 310}, // C6 (High)
+        {880, 250, 260},  // A5
+        {987, 400, 450},  // B5
+    };
+
+    const Note LOSE_NOTES[] = {
+        {440, 250, 260}, // A4
+        {415, 200, 210}, // G#4
+        {392, 250, 260}, // G4
+        {349, 300, 310}, // F4
+        {261, 450, 460}, // C4 (Low)
+    };
+
+    const Note ROUND_START_NOTES[] = {
+        {440, 200, 210}, // A4
+        {523, 200, 210}, // C5
+        {659, 200, 210}, // E5
+        {784, 200, 210}, // G5
+        {880, 200, 210}, // A5
+    };
+
+    // *** CREDITS TO CHATGPT FOR THIS MELODY
+    const Note IMPERIAL_MARCH_NOTES[] = {
+        {440, 400, 450}, // A4
+        {440, 400, 450}, // A4
+        {440, 400, 450}, // A4
+        {349, 300, 350}, // F4
+        {523, 150, 200}, // C5
+        {440, 400, 450}, // A4
+        {349, 300, 350}, // F4
+        {523, 150, 200}, // C5
+        {440, 800, 850}, // A4
+
+        {659, 400, 450}, // E5
+        {659, 400, 450}, // E5
+        {659, 400, 450}, // E5
+        {698, 300, 350}, // F5
+        {523, 150, 200}, // C5
+        {415, 400, 450}, // G#4
+        {349, 300, 350}, // F4
+        {523, 150, 200}, // C5
+        {440, 800, 850}, // A4
+    };
+
+    template <size_t N>
+    constexpr Melody melodyOf(const Note (&notes)[N], uint16_t pauseMs)
+    {
+        return {notes, static_cast<uint8_t>(N), pauseMs};
+    }
+
+    constexpr Melody MELODIES[] = {
+        melodyOf(WIN_NOTES, 200),
+        melodyOf(LOSE_NOTES, 200),
+        melodyOf(ROUND_START_NOTES, 200),
+        melodyOf(IMPERIAL_MARCH_NOTES, 400),
+    };
+
+    static_assert(sizeof(MELODIES) / sizeof(MELODIES[0]) == static_cast<size_t>(MelodyId::Count), "Melody table out of sync");
+}
+
+/**
+ * @brief Mounts the asset pack, call once at boot before using any asset.
+ */
+void Assets::begin()
+{
+    AssetPack::mount();
+}
+
+/**
+ * @brief Returns the text of a UI string.
+ */
+const char *Assets::string(StringId id)
+{
+    const char *text = AssetPack::string(static_cast<uint8_t>(id));
+    return text != nullptr ? text : STRINGS[static_cast<uint8_t>(id)];
+}
+
+/**
+ * @brief Returns the 8-row bitmap of a custom character.
+ */
+const uint8_t *Assets::glyph(GlyphId id)
+{
+    const uint8_t *bitmap = AssetPack::glyph(static_cast<uint8_t>(id));
+    return bitmap != nullptr ? bitmap : GLYPHS[static_cast<uint8_t>(id)];
+}
+
+/**
+ * @brief Returns a melody, the notes are read in place.
+ */
+Melody Assets::melody(MelodyId id)
+{
+    Melody melody;
+    if (AssetPack::melody(static_cast<uint8_t>(id), melody))
+        return melody;
+    return MELODIES[static_cast<uint8_t>(id)];
+}
+
+/**
+ * @brief Looks up a tuning override from the asset pack.
+ */
+bool Assets::tuning(TuningKey key, int32_t &value)
+{
+    return AssetPack::tuning(static_cast<uint16_t>(key), value);
+}
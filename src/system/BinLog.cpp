@@ -0,0 +1,153 @@
+#include "BinLog.h"
+
+namespace
+{
+    // Sync, format and length before the payload, checksum after it
+    constexpr uint8_t RECORD_OVERHEAD = 3 + 1;
+    // Payload: timestamp (5), arguments (5 each)
+    constexpr uint8_t MAX_RECORD_SIZE = RECORD_OVERHEAD + 5 + 5 * BinLog::MAX_ARGS;
+#ifdef SERIAL_TX_BUFFER_SIZE
+    // drain() waits until a whole record fits, which must happen with an empty transmit buffer
+    static_assert(MAX_RECORD_SIZE < SERIAL_TX_BUFFER_SIZE, "A record must fit the UART transmit buffer");
+#endif
+    constexpr uint16_t RING_MASK = BinLog::RING_SIZE - 1;
+
+    static_assert((BinLog::RING_SIZE & RING_MASK) == 0, "RING_SIZE must be a power of two");
+
+    uint8_t ring[BinLog::RING_SIZE];
+    volatile uint16_t head = 0; // Written by the producer only
+    volatile uint16_t tail = 0; // Written by the consumer only
+
+    uint32_t dropped = 0;
+    uint32_t droppedReported = 0;
+
+    uint8_t putVarint(uint8_t *out, uint8_t pos, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            out[pos++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        out[pos++] = (uint8_t)value;
+        return pos;
+    }
+
+    uint32_t zigzag(int32_t value)
+    {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+}
+
+/**
+ * @brief Appends a record to the ring.
+ *
+ * The record is encoded on the stack first and only committed (head moved)
+ * once it is complete, so the consumer never sees a partial record.
+ *
+ * @param format Format ID.
+ * @param args   Argument values.
+ * @param argc   Number of arguments (at most MAX_ARGS).
+ */
+void BinLog::write(LogFormat format, const int32_t *args, uint8_t argc)
+{
+    uint8_t record[MAX_RECORD_SIZE];
+    uint8_t len = 0;
+
+    if (argc > MAX_ARGS)
+        argc = MAX_ARGS;
+
+    record[len++] = SYNC;
+    record[len++] = static_cast<uint8_t>(format);
+    record[len++] = 0; // Payload length, filled in below
+    len = putVarint(record, len, millis());
+    for (uint8_t i = 0; i < argc; i++)
+    {
+        len = putVarint(record, len, zigzag(args[i]));
+    }
+    record[2] = len - 3;
+
+    uint8_t checksum = 0;
+    for (uint8_t i = 1; i < len; i++)
+    {
+        checksum += record[i];
+    }
+    record[len++] = checksum;
+
+    uint16_t h = head;
+    uint16_t used = (h - tail) & RING_MASK;
+    if (RING_SIZE - 1 - used < len)
+    {
+        dropped++;
+        return;
+    }
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        ring[(h + i) & RING_MASK] = record[i];
+    }
+    head = (h + len) & RING_MASK;
+}
+
+/**
+ * @brief Moves as many whole records as the UART can take without blocking.
+ *
+ * HardwareSerial copies the bytes into its own interrupt-driven transmit
+ * buffer, so this returns immediately. A record is only sent once it fits
+ * completely: console text printed between two drains then always lands
+ * between records, never inside one where the decoder would drop it. Also
+ * reports dropped records once there is room again.
+ */
+void BinLog::drain()
+{
+    if (dropped != droppedReported)
+    {
+        uint32_t before = dropped;
+        log(LogFormat::LogDropped, before - droppedReported);
+        if (dropped == before)
+            droppedReported = before;
+        else
+            dropped = before; // The report did not fit either, retry next time
+    }
+
+    int room = Serial.availableForWrite();
+    uint16_t t = tail;
+    uint16_t used = (head - t) & RING_MASK;
+    while (used > 0)
+    {
+        uint16_t size = RECORD_OVERHEAD + ring[(t + 2) & RING_MASK];
+        if (size > room)
+            break;
+
+        // A record that wraps around the end of the ring goes out in two pieces
+        uint16_t first = RING_SIZE - t;
+        if (first > size)
+            first = size;
+        Serial.write(&ring[t], first);
+        if (first < size)
+            Serial.write(&ring[0], size - first);
+
+        t = (t + size) & RING_MASK;
+        used -= size;
+        room -= size;
+    }
+    tail = t;
+}
+
+/**
+ * @brief Blocks until every queued record has been handed to the UART.
+ */
+void BinLog::flush()
+{
+    while (head != tail)
+    {
+        drain();
+    }
+}
+
+/**
+ * @brief Number of records dropped because the ring was full.
+ */
+uint32_t BinLog::droppedCount()
+{
+    return dropped;
+}
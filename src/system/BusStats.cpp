@@ -0,0 +1,5 @@
+#include "BusStats.h"
+
+#ifdef ENABLE_BUS_STATS
+BusStats::Counters BusStats::counters = {};
+#endif
@@ -0,0 +1,84 @@
+#include "Checkpoint.h"
+#include "FlashKvStore.h"
+#include "FlashLayout.h"
+#include "Log.h"
+
+namespace
+{
+    // Challenge in the low byte, progress above it; 0 when no session is running
+    constexpr uint16_t SESSION_KEY = 1;
+    constexpr uint16_t ELAPSED_KEY = 2;
+
+    FlashKvStore checkpointStore(FlashLayout::CHECKPOINT_ADDR, FlashLayout::CHECKPOINT_PAGES, FlashLayout::PAGE_BYTES);
+    bool storeReady = false;
+
+    int32_t savedSession = 0;
+    unsigned long lastSave = 0;
+
+    int32_t packSession(const Checkpoint::Session &session)
+    {
+        return (int32_t)(session.challenge | (session.progress << 8));
+    }
+}
+
+/**
+ * @brief Mounts the checkpoint store and reads the saved session.
+ *
+ * @param session Set to the saved session if there is one.
+ * @return true if a session was running when the board went down.
+ */
+bool Checkpoint::restore(Session &session)
+{
+    storeReady = checkpointStore.begin();
+    if (!storeReady)
+    {
+        LOG_ERROR(SYSTEM, CheckpointFailed);
+        return false;
+    }
+
+    int32_t word;
+    int32_t elapsed;
+    if (!checkpointStore.read(SESSION_KEY, word) || word == 0 || !checkpointStore.read(ELAPSED_KEY, elapsed))
+        return false;
+
+    savedSession = word;
+    session.challenge = (uint8_t)word;
+    session.progress = (uint32_t)word >> 8;
+    session.elapsedMs = (uint32_t)elapsed;
+    LOG_INFO(SYSTEM, CheckpointRestored, session.challenge, session.progress, session.elapsedMs);
+    return true;
+}
+
+/**
+ * @brief Saves the session if its challenge or progress changed or the save interval elapsed.
+ *
+ * The elapsed time goes first: a power cut between the two writes then
+ * leaves the previous session word, never a new session with an old time.
+ */
+void Checkpoint::save(const Session &session)
+{
+    if (!storeReady)
+        return;
+
+    unsigned long now = millis();
+    int32_t word = packSession(session);
+    if (word == savedSession && now - lastSave < SAVE_INTERVAL_MS)
+        return;
+
+    checkpointStore.write(ELAPSED_KEY, (int32_t)session.elapsedMs);
+    checkpointStore.write(SESSION_KEY, word);
+    savedSession = word;
+    lastSave = now;
+}
+
+/**
+ * @brief Marks the session as finished so the next boot starts fresh.
+ */
+void Checkpoint::clear()
+{
+    if (!storeReady)
+        return;
+
+    checkpointStore.write(SESSION_KEY, 0);
+    savedSession = 0;
+}
@@ -0,0 +1,6 @@
+#include "Clock.h"
+
+#ifdef ENABLE_VIRTUAL_CLOCK
+bool Clock::active = false;
+unsigned long Clock::virtualMs = 0;
+#endif
@@ -0,0 +1,156 @@
+#include "Console.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+    const Console::Command *commandTable = nullptr;
+    uint8_t commandCount = 0;
+
+    char line[Console::LINE_BYTES];
+    uint8_t lineLength = 0;
+    bool overflow = false; // Discarding the rest of an over-long line
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+
+    /**
+     * @brief Splits the line in place, terminating each argument.
+     */
+    Console::Args tokenize()
+    {
+        Console::Args args;
+        args.count = 0;
+
+        char *cursor = line;
+        while (*cursor != '\0' && args.count < Console::MAX_ARGS)
+        {
+            while (isSpace(*cursor))
+                cursor++;
+            if (*cursor == '\0')
+                break;
+            args.values[args.count++] = cursor;
+            while (*cursor != '\0' && !isSpace(*cursor))
+                cursor++;
+            if (*cursor != '\0')
+                *cursor++ = '\0';
+        }
+        return args;
+    }
+
+    void dispatch(Print &out)
+    {
+        Console::Args args = tokenize();
+        if (args.count == 0)
+            return;
+
+        for (uint8_t i = 0; i < commandCount; i++)
+        {
+            if (strcmp(commandTable[i].name, args.values[0]) == 0)
+            {
+                commandTable[i].handler(args, out);
+                return;
+            }
+        }
+        out.print("unknown command '");
+        out.print(args.values[0]);
+        out.println("', try help");
+    }
+}
+
+/**
+ * @brief Parses an argument as a signed decimal integer.
+ *
+ * @param index Argument index, 1 is the first after the command name.
+ * @param value Set to the parsed value.
+ * @return false if the argument is missing or not a number.
+ */
+bool Console::Args::toInt(uint8_t index, long &value) const
+{
+    if (index >= count)
+        return false;
+
+    char *end;
+    long parsed = strtol(values[index], &end, 10);
+    if (end == values[index] || *end != '\0')
+        return false;
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Sets the command table.
+ *
+ * @param commands Table, must outlive the console.
+ * @param count    Number of entries.
+ */
+void Console::begin(const Command *commands, uint8_t count)
+{
+    commandTable = commands;
+    commandCount = count;
+    lineLength = 0;
+    overflow = false;
+}
+
+/**
+ * @brief Reads pending input and runs at most one complete command.
+ *
+ * Accepts CR, LF or CRLF line endings and handles backspace, so both
+ * terminal programs and scripts can drive it.
+ *
+ * @param port Serial port to read from and reply to.
+ */
+void Console::poll(Stream &port)
+{
+    for (uint8_t budget = MAX_BYTES_PER_POLL; budget > 0 && port.available() > 0; budget--)
+    {
+        char c = (char)port.read();
+
+        if (c == '\r' || c == '\n')
+        {
+            bool complete = !overflow && lineLength > 0;
+            line[lineLength] = '\0';
+            lineLength = 0;
+            if (overflow)
+                port.println("line too long");
+            overflow = false;
+            if (complete)
+            {
+                dispatch(port);
+                return;
+            }
+        }
+        else if (c == '\b' || c == 0x7F)
+        {
+            if (lineLength > 0)
+                lineLength--;
+        }
+        else if (lineLength < LINE_BYTES - 1)
+        {
+            line[lineLength++] = c;
+        }
+        else
+        {
+            overflow = true;
+        }
+    }
+}
+
+/**
+ * @brief Lists the commands with their usage.
+ */
+void Console::printHelp(Print &out)
+{
+    for (uint8_t i = 0; i < commandCount; i++)
+    {
+        const Command &command = commandTable[i];
+        uint8_t width = out.print(command.name);
+        out.print(' ');
+        width += 1 + out.print(command.usage);
+        while (width++ < 20)
+            out.print(' ');
+        out.println(command.description);
+    }
+}
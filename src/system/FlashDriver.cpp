@@ -0,0 +1,120 @@
+#include "FlashDriver.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+/**
+ * @brief Erases one page, every byte reads 0xFF afterwards.
+ *
+ * @param address Start of the page.
+ * @return true on success.
+ */
+bool FlashDriver::erasePage(uintptr_t address)
+{
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.PageAddress = address;
+    erase.NbPages = 1;
+    uint32_t pageError = 0;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &pageError);
+    HAL_FLASH_Lock();
+
+    return status == HAL_OK;
+}
+
+/**
+ * @brief Programs consecutive half-words, the target must be erased.
+ *
+ * @param address   Half-word aligned destination.
+ * @param halfWords Values to write.
+ * @param count     Number of half-words.
+ * @return true on success.
+ */
+bool FlashDriver::program(uintptr_t address, const uint16_t *halfWords, uint8_t count)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    HAL_FLASH_Unlock();
+    for (uint8_t i = 0; i < count && status == HAL_OK; i++)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address + 2 * i, halfWords[i]);
+    }
+    HAL_FLASH_Lock();
+
+    return status == HAL_OK;
+}
+
+#else // Host build, see FlashDriver::Sim
+
+#include "FlashLayout.h"
+#include <string.h>
+
+namespace
+{
+    uint32_t budget = UINT32_MAX;
+    uint32_t performed = 0;
+    bool lost = false;
+
+    // Counts an operation, false once the power is gone
+    bool powered()
+    {
+        if (lost || performed >= budget)
+        {
+            lost = true;
+            return false;
+        }
+        performed++;
+        return true;
+    }
+}
+
+void FlashDriver::Sim::cutPowerAfter(uint32_t operations)
+{
+    budget = performed + operations;
+}
+
+void FlashDriver::Sim::restorePower()
+{
+    budget = UINT32_MAX;
+    performed = 0;
+    lost = false;
+}
+
+bool FlashDriver::Sim::powerLost()
+{
+    return lost;
+}
+
+uint32_t FlashDriver::Sim::operations()
+{
+    return performed;
+}
+
+bool FlashDriver::erasePage(uintptr_t address)
+{
+    bool dying = !lost; // Refused now, this is the erase the power dies in
+    if (!powered())
+    {
+        if (dying)
+            memset(reinterpret_cast<void *>(address), 0xFF, FlashLayout::PAGE_BYTES / 2);
+        return false;
+    }
+    memset(reinterpret_cast<void *>(address), 0xFF, FlashLayout::PAGE_BYTES);
+    return true;
+}
+
+bool FlashDriver::program(uintptr_t address, const uint16_t *halfWords, uint8_t count)
+{
+    uint16_t *target = reinterpret_cast<uint16_t *>(address);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (!powered() || target[i] != 0xFFFF)
+            return false;
+        target[i] = halfWords[i];
+    }
+    return true;
+}
+
+#endif // ARDUINO
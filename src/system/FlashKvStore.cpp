@@ -0,0 +1,233 @@
+#include "FlashKvStore.h"
+#include "FlashDriver.h"
+#include "Crc32.h"
+
+/**
+ * @brief Constructs a store over consecutive flash pages.
+ *
+ * @param baseAddr  Start of the first page.
+ * @param pageCount Number of pages to rotate through (at least 2).
+ * @param pageBytes Size of one page.
+ */
+FlashKvStore::FlashKvStore(uintptr_t baseAddr, uint8_t pageCount, uint16_t pageBytes)
+    : base(baseAddr), pages(pageCount), pageBytes(pageBytes), activePage(0), sequence(0), writeOffset(HEADER_BYTES)
+{
+}
+
+/**
+ * @brief Finds the active page, formats the store if there is none.
+ *
+ * The active page is the one with a valid header and the newest sequence
+ * number (wrap-around safe). A page whose copy was cut short has no header
+ * yet and is ignored, the inverted sequence guards against a page whose
+ * erase was cut short.
+ *
+ * @return false if the flash could not be formatted.
+ */
+bool FlashKvStore::begin()
+{
+    bool found = false;
+    for (uint8_t page = 0; page < pages; page++)
+    {
+        const uint32_t *header = reinterpret_cast<const uint32_t *>(pageAddr(page));
+        uint16_t pageSequence = (uint16_t)header[1];
+        if (header[0] != MAGIC || (uint16_t)(header[1] >> 16) != (uint16_t)~pageSequence)
+            continue;
+        if (!found || (int16_t)(pageSequence - sequence) > 0)
+        {
+            found = true;
+            activePage = page;
+            sequence = pageSequence;
+        }
+    }
+
+    if (!found)
+    {
+        activePage = 0;
+        sequence = 0;
+        if (!FlashDriver::erasePage(pageAddr(0)) || !programHeader(pageAddr(0), sequence))
+            return false;
+    }
+
+    // Records are appended in order, the first erased slot follows the last used one
+    writeOffset = HEADER_BYTES;
+    while (writeOffset + RECORD_BYTES <= pageBytes && !isErased(writeOffset))
+    {
+        writeOffset += RECORD_BYTES;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the latest value of a key.
+ *
+ * @param key   Key to look up.
+ * @param value Set to the stored value if found.
+ * @return true if the key has a value.
+ */
+bool FlashKvStore::read(uint16_t key, int32_t &value) const
+{
+    bool found = false;
+    for (uint16_t offset = HEADER_BYTES; offset < writeOffset; offset += RECORD_BYTES)
+    {
+        const Record &record = *recordAt(offset);
+        if (record.key == key && isValid(record))
+        {
+            value = record.value;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Stores a value, skipping the write if it is unchanged.
+ *
+ * @param key   Key, anything but INVALID_KEY.
+ * @param value Value to store.
+ * @return true on success.
+ */
+bool FlashKvStore::write(uint16_t key, int32_t value)
+{
+    if (key == INVALID_KEY)
+        return false;
+
+    int32_t current;
+    if (read(key, current) && current == value)
+        return true;
+
+    if (writeOffset + RECORD_BYTES > pageBytes)
+        return rotate(key, value);
+
+    // A failed slot stays used, the next write goes after it
+    uint16_t offset = writeOffset;
+    writeOffset += RECORD_BYTES;
+    return programRecord(pageAddr(activePage) + offset, key, value);
+}
+
+/**
+ * @brief Number of page rotations since the store was formatted.
+ */
+uint16_t FlashKvStore::generation() const
+{
+    return sequence;
+}
+
+/**
+ * @brief Free record slots left in the active page.
+ */
+uint16_t FlashKvStore::freeRecords() const
+{
+    return (pageBytes - writeOffset) / RECORD_BYTES;
+}
+
+uintptr_t FlashKvStore::pageAddr(uint8_t page) const
+{
+    return base + (uintptr_t)page * pageBytes;
+}
+
+const FlashKvStore::Record *FlashKvStore::recordAt(uint16_t offset) const
+{
+    return reinterpret_cast<const Record *>(pageAddr(activePage) + offset);
+}
+
+bool FlashKvStore::isErased(uint16_t offset) const
+{
+    const uint32_t *words = reinterpret_cast<const uint32_t *>(recordAt(offset));
+    return words[0] == 0xFFFFFFFF && words[1] == 0xFFFFFFFF;
+}
+
+bool FlashKvStore::isValid(const Record &record) const
+{
+    return record.key != INVALID_KEY && record.check == checkOf(record.key, record.value);
+}
+
+/**
+ * @brief True if no later valid record in the active page has the same key.
+ */
+bool FlashKvStore::isLatest(uint16_t offset) const
+{
+    uint16_t key = recordAt(offset)->key;
+    for (uint16_t later = offset + RECORD_BYTES; later < writeOffset; later += RECORD_BYTES)
+    {
+        const Record &record = *recordAt(later);
+        if (record.key == key && isValid(record))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves the live records and the new value to the next page.
+ *
+ * The old page stays valid until the new header is written, so a power cut
+ * during the copy leaves the store as it was before the write.
+ */
+bool FlashKvStore::rotate(uint16_t key, int32_t value)
+{
+    uint8_t target = (activePage + 1) % pages;
+    uintptr_t targetAddr = pageAddr(target);
+
+    if (!FlashDriver::erasePage(targetAddr))
+        return false;
+
+    uint16_t targetOffset = HEADER_BYTES;
+    for (uint16_t offset = HEADER_BYTES; offset < writeOffset; offset += RECORD_BYTES)
+    {
+        const Record &record = *recordAt(offset);
+        if (!isValid(record) || record.key == key || !isLatest(offset))
+            continue;
+        if (targetOffset + RECORD_BYTES > pageBytes || !programRecord(targetAddr + targetOffset, record.key, record.value))
+            return false;
+        targetOffset += RECORD_BYTES;
+    }
+
+    if (targetOffset + RECORD_BYTES > pageBytes || !programRecord(targetAddr + targetOffset, key, value))
+        return false;
+    targetOffset += RECORD_BYTES;
+
+    if (!programHeader(targetAddr, (uint16_t)(sequence + 1)))
+        return false;
+
+    activePage = target;
+    sequence++;
+    writeOffset = targetOffset;
+    return true;
+}
+
+/**
+ * @brief Programs a record, the check goes last so a torn write never validates.
+ */
+bool FlashKvStore::programRecord(uintptr_t address, uint16_t key, int32_t value)
+{
+    uint16_t words[2] = {(uint16_t)((uint32_t)value & 0xFFFF), (uint16_t)((uint32_t)value >> 16)};
+    uint16_t check = checkOf(key, value);
+
+    return FlashDriver::program(address + 4, words, 2) &&
+           FlashDriver::program(address, &key, 1) &&
+           FlashDriver::program(address + 2, &check, 1);
+}
+
+/**
+ * @brief Programs a page header, the magic goes last so a torn header never validates.
+ */
+bool FlashKvStore::programHeader(uintptr_t address, uint16_t sequence)
+{
+    uint16_t sequenceWords[2] = {sequence, (uint16_t)~sequence};
+    uint16_t magicWords[2] = {(uint16_t)(MAGIC & 0xFFFF), (uint16_t)(MAGIC >> 16)};
+
+    return FlashDriver::program(address + 4, sequenceWords, 2) &&
+           FlashDriver::program(address, magicWords, 2);
+}
+
+/**
+ * @brief 16-bit check over key and value, never 0xFFFF (an unwritten check).
+ */
+uint16_t FlashKvStore::checkOf(uint16_t key, int32_t value)
+{
+    uint8_t bytes[6] = {
+        (uint8_t)key, (uint8_t)(key >> 8),
+        (uint8_t)value, (uint8_t)((uint32_t)value >> 8), (uint8_t)((uint32_t)value >> 16), (uint8_t)((uint32_t)value >> 24)};
+    uint16_t check = (uint16_t)Crc32::compute(bytes, sizeof(bytes));
+    return check == 0xFFFF ? 0 : check;
+}
@@ -0,0 +1,177 @@
+#include "FlashRecordLog.h"
+#include "FlashDriver.h"
+#include "Crc32.h"
+#include <string.h>
+
+/**
+ * @brief Constructs a log over consecutive flash pages.
+ *
+ * @param baseAddr    Start of the first page.
+ * @param pageCount   Number of pages to rotate through (at least 2).
+ * @param pageBytes   Size of one page.
+ * @param recordBytes Payload size, a multiple of 4.
+ */
+FlashRecordLog::FlashRecordLog(uintptr_t baseAddr, uint8_t pageCount, uint16_t pageBytes, uint16_t recordBytes)
+    : base(baseAddr), pages(pageCount), pageBytes(pageBytes), recordBytes(recordBytes),
+      slotBytes(recordBytes + 4), slotsPerPage(pageBytes / (recordBytes + 4)), writeSlot(0), nextSequence(0)
+{
+}
+
+/**
+ * @brief Finds the newest record and the next free slot.
+ *
+ * Sequence numbers are compared wrap-around safe; the log never holds more
+ * than 32768 records, so the newest one is unambiguous.
+ */
+void FlashRecordLog::begin()
+{
+    bool found = false;
+    uint16_t newestSlot = 0;
+    uint16_t newestSequence = 0;
+    for (uint16_t slot = 0; slot < capacity(); slot++)
+    {
+        if (!isValid(slot))
+            continue;
+        uint16_t sequence = sequenceAt(slot);
+        if (!found || (int16_t)(sequence - newestSequence) > 0)
+        {
+            found = true;
+            newestSlot = slot;
+            newestSequence = sequence;
+        }
+    }
+
+    writeSlot = found ? (newestSlot + 1) % capacity() : 0;
+    nextSequence = found ? (uint16_t)(newestSequence + 1) : 0;
+}
+
+/**
+ * @brief Appends a record, erasing the oldest page when needed.
+ *
+ * Slots left behind by a torn write are skipped. Payload and sequence go
+ * first and the check last.
+ *
+ * @param payload recordBytes bytes.
+ * @return false if the flash could not be erased or programmed.
+ */
+bool FlashRecordLog::append(const void *payload)
+{
+    // Skip torn slots; entering a page always erases it, an interrupted
+    // erase can leave old records behind an erased first slot
+    while (writeSlot % slotsPerPage != 0 && !isErased(writeSlot))
+    {
+        writeSlot = (writeSlot + 1) % capacity();
+    }
+    if (writeSlot % slotsPerPage == 0 && !FlashDriver::erasePage(slotAddr(writeSlot)))
+        return false;
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(payload);
+    uint16_t sequence = nextSequence;
+    uint16_t check = checkOf(bytes, sequence);
+    uintptr_t address = slotAddr(writeSlot);
+
+    // A failed slot stays used, the next record goes after it
+    writeSlot = (writeSlot + 1) % capacity();
+    nextSequence++;
+
+    uint16_t words[32];
+    for (uint16_t offset = 0; offset < recordBytes; offset += sizeof(words))
+    {
+        uint16_t chunk = recordBytes - offset;
+        if (chunk > sizeof(words))
+            chunk = sizeof(words);
+        memcpy(words, bytes + offset, chunk);
+        if (!FlashDriver::program(address + offset, words, chunk / 2))
+            return false;
+    }
+    return FlashDriver::program(address + recordBytes, &sequence, 1) &&
+           FlashDriver::program(address + recordBytes + 2, &check, 1);
+}
+
+/**
+ * @brief Copies the next record, oldest first.
+ *
+ * The oldest records sit in the page after the one holding the last
+ * written slot, the cursor counts slots from the start of that page.
+ *
+ * @param cursor  Iteration state, advanced past the returned record.
+ * @param payload Receives recordBytes bytes.
+ * @return false when there are no more records.
+ */
+bool FlashRecordLog::next(uint16_t &cursor, void *payload) const
+{
+    uint16_t lastSlot = (writeSlot + capacity() - 1) % capacity();
+    uint16_t oldestSlot = (lastSlot / slotsPerPage + 1) % pages * slotsPerPage;
+    while (cursor < capacity())
+    {
+        uint16_t slot = (oldestSlot + cursor) % capacity();
+        cursor++;
+        if (isValid(slot))
+        {
+            memcpy(payload, reinterpret_cast<const void *>(slotAddr(slot)), recordBytes);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Erases every page.
+ */
+bool FlashRecordLog::clear()
+{
+    for (uint8_t page = 0; page < pages; page++)
+    {
+        if (!FlashDriver::erasePage(base + (uintptr_t)page * pageBytes))
+            return false;
+    }
+    writeSlot = 0;
+    nextSequence = 0;
+    return true;
+}
+
+/**
+ * @brief Number of record slots, the most records the log can ever hold.
+ */
+uint16_t FlashRecordLog::capacity() const
+{
+    return pages * slotsPerPage;
+}
+
+uintptr_t FlashRecordLog::slotAddr(uint16_t slot) const
+{
+    return base + (uintptr_t)(slot / slotsPerPage) * pageBytes + (uintptr_t)(slot % slotsPerPage) * slotBytes;
+}
+
+bool FlashRecordLog::isErased(uint16_t slot) const
+{
+    const uint32_t *words = reinterpret_cast<const uint32_t *>(slotAddr(slot));
+    for (uint16_t i = 0; i < slotBytes / 4; i++)
+    {
+        if (words[i] != 0xFFFFFFFF)
+            return false;
+    }
+    return true;
+}
+
+bool FlashRecordLog::isValid(uint16_t slot) const
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(slotAddr(slot));
+    uint16_t check = *reinterpret_cast<const uint16_t *>(bytes + recordBytes + 2);
+    return check != 0xFFFF && check == checkOf(bytes, sequenceAt(slot));
+}
+
+uint16_t FlashRecordLog::sequenceAt(uint16_t slot) const
+{
+    return *reinterpret_cast<const uint16_t *>(slotAddr(slot) + recordBytes);
+}
+
+/**
+ * @brief 16-bit check over payload and sequence, never 0xFFFF (an unwritten check).
+ */
+uint16_t FlashRecordLog::checkOf(const uint8_t *payload, uint16_t sequence) const
+{
+    uint8_t sequenceBytes[2] = {(uint8_t)sequence, (uint8_t)(sequence >> 8)};
+    uint16_t check = (uint16_t)Crc32::compute(sequenceBytes, sizeof(sequenceBytes), Crc32::compute(payload, recordBytes));
+    return check == 0xFFFF ? 0 : check;
+}
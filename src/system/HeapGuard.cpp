@@ -0,0 +1,168 @@
+#include "HeapGuard.h"
+
+#ifdef ENABLE_HEAP_GUARD
+
+#include "Log.h"
+#include <malloc.h>
+#ifndef ARDUINO
+#include <assert.h>
+#endif
+
+namespace
+{
+    HeapGuard::Stats counters = {};
+    bool heapLocked = false;
+
+    void recordAllocation(void *block, size_t size, uintptr_t caller)
+    {
+        if (block == nullptr)
+            return;
+
+        counters.allocations++;
+        counters.bytesRequested += size;
+        counters.bytesInUse += malloc_usable_size(block);
+        if (counters.bytesInUse > counters.peakBytesInUse)
+            counters.peakBytesInUse = counters.bytesInUse;
+
+        if (heapLocked)
+        {
+            counters.lockedAllocations++;
+            counters.lastLockedCaller = caller;
+            LOG_ERROR(SYSTEM, HeapAllocAfterLock, size, caller);
+#ifndef ARDUINO
+            assert(!"heap allocation after HeapGuard::lock()");
+#endif
+        }
+    }
+
+    void recordFree(void *block)
+    {
+        if (block == nullptr)
+            return;
+        counters.frees++;
+        counters.bytesInUse -= malloc_usable_size(block);
+    }
+}
+
+extern "C"
+{
+    void *__real_malloc(size_t size);
+    void __real_free(void *block);
+    void *__real_calloc(size_t count, size_t size);
+    void *__real_realloc(void *block, size_t size);
+
+    void *__wrap_malloc(size_t size)
+    {
+        void *block = __real_malloc(size);
+        recordAllocation(block, size, (uintptr_t)__builtin_return_address(0));
+        return block;
+    }
+
+    void __wrap_free(void *block)
+    {
+        recordFree(block);
+        __real_free(block);
+    }
+
+    void *__wrap_calloc(size_t count, size_t size)
+    {
+        void *block = __real_calloc(count, size);
+        recordAllocation(block, count * size, (uintptr_t)__builtin_return_address(0));
+        return block;
+    }
+
+    void *__wrap_realloc(void *block, size_t size)
+    {
+        // Counted as a free of the old block and an allocation of the new one
+        size_t oldSize = block != nullptr ? malloc_usable_size(block) : 0;
+        void *resized = __real_realloc(block, size);
+        if (resized == nullptr && size != 0)
+            return nullptr; // The old block is untouched
+
+        if (block != nullptr)
+        {
+            counters.frees++;
+            counters.bytesInUse -= oldSize;
+        }
+        recordAllocation(resized, size, (uintptr_t)__builtin_return_address(0));
+        return resized;
+    }
+}
+
+// new/delete go through the same counters whichever C++ runtime the
+// toolchain links, with the caller of new as the reported address
+void *operator new(size_t size)
+{
+    void *block = __real_malloc(size);
+    recordAllocation(block, size, (uintptr_t)__builtin_return_address(0));
+    return block;
+}
+
+void *operator new[](size_t size)
+{
+    void *block = __real_malloc(size);
+    recordAllocation(block, size, (uintptr_t)__builtin_return_address(0));
+    return block;
+}
+
+void operator delete(void *block) noexcept
+{
+    __wrap_free(block);
+}
+
+void operator delete[](void *block) noexcept
+{
+    __wrap_free(block);
+}
+
+void operator delete(void *block, size_t) noexcept
+{
+    __wrap_free(block);
+}
+
+void operator delete[](void *block, size_t) noexcept
+{
+    __wrap_free(block);
+}
+
+/**
+ * @brief Forbids further allocations, call at the end of setup().
+ */
+void HeapGuard::lock()
+{
+    heapLocked = true;
+}
+
+/**
+ * @brief Current counters.
+ */
+HeapGuard::Stats HeapGuard::stats()
+{
+    return counters;
+}
+
+/**
+ * @brief Prints the counters.
+ */
+void HeapGuard::print(Print &out)
+{
+    out.print("heap: ");
+    out.print(counters.allocations);
+    out.print(" allocs, ");
+    out.print(counters.frees);
+    out.print(" frees, ");
+    out.print(counters.bytesInUse);
+    out.print(" B in use, peak ");
+    out.print(counters.peakBytesInUse);
+    out.print(" B, ");
+    out.print(counters.lockedAllocations);
+    out.print(heapLocked ? " after lock" : " after lock (not locked)");
+    if (counters.lockedAllocations > 0)
+    {
+        out.print(", last from 0x");
+        out.print((unsigned long)counters.lastLockedCaller, HEX);
+    }
+    out.println();
+}
+
+#endif // ENABLE_HEAP_GUARD
@@ -0,0 +1,175 @@
+#include "MemStats.h"
+#include "Log.h"
+
+#ifdef ARDUINO
+#include <unistd.h>
+
+// Symbols from the STM32 linker script
+extern "C" uint32_t _sdata, _edata, _sbss, _ebss, _end, _estack;
+#endif
+
+namespace
+{
+    /**
+     * @brief Section boundaries, all word aligned.
+     */
+    struct RamMap
+    {
+        uintptr_t ramStart;
+        uintptr_t dataEnd;
+        uintptr_t bssStart;
+        uintptr_t bssEnd;
+        uintptr_t heapEnd;
+        uintptr_t stackTop;
+    };
+
+    // Lowest painted word, the stack never grew below what begin() painted
+    uint32_t *paintLow = nullptr;
+    uint32_t *paintHigh = nullptr;
+#if MEM_REPORT_INTERVAL_MS > 0
+    unsigned long lastReport = 0;
+#endif
+
+#ifdef ARDUINO
+    RamMap ramMap()
+    {
+        RamMap map;
+        map.ramStart = (uintptr_t)&_sdata;
+        map.dataEnd = (uintptr_t)&_edata;
+        map.bssStart = (uintptr_t)&_sbss;
+        map.bssEnd = (uintptr_t)&_ebss;
+        map.heapEnd = ((uintptr_t)sbrk(0) + 3) & ~(uintptr_t)3;
+        map.stackTop = (uintptr_t)&_estack;
+        return map;
+    }
+
+    uintptr_t stackPointer()
+    {
+        uint32_t marker;
+        return (uintptr_t)&marker;
+    }
+#else
+    // .data 1 KB, .bss 2 KB, heap 1 KB, then the stack
+    RamMap ramMap()
+    {
+        uintptr_t base = (uintptr_t)MemStats::simulatedRam;
+        RamMap map;
+        map.ramStart = base;
+        map.dataEnd = base + 1024;
+        map.bssStart = base + 1024;
+        map.bssEnd = base + 3 * 1024;
+        map.heapEnd = base + 4 * 1024;
+        map.stackTop = base + MemStats::SIMULATED_RAM_BYTES;
+        return map;
+    }
+
+    uintptr_t stackPointer()
+    {
+        return ramMap().stackTop;
+    }
+#endif
+}
+
+#ifndef ARDUINO
+uint32_t MemStats::simulatedRam[SIMULATED_RAM_BYTES / 4];
+#endif
+
+/**
+ * @brief Fills a region with PAINT_PATTERN.
+ */
+void MemStats::paint(const Region &region)
+{
+    for (uint32_t *word = region.low; word < region.high; word++)
+    {
+        *word = PAINT_PATTERN;
+    }
+}
+
+/**
+ * @brief Bytes at the low end of a region that still hold the pattern.
+ */
+uint32_t MemStats::untouchedBytes(const Region &region)
+{
+    const uint32_t *word = region.low;
+    while (word < region.high && *word == PAINT_PATTERN)
+    {
+        word++;
+    }
+    return (uint32_t)((uintptr_t)word - (uintptr_t)region.low);
+}
+
+/**
+ * @brief Paints the free RAM below the current stack pointer.
+ */
+void MemStats::begin()
+{
+    RamMap map = ramMap();
+    paintLow = reinterpret_cast<uint32_t *>(map.heapEnd);
+    paintHigh = reinterpret_cast<uint32_t *>(stackPointer() & ~(uintptr_t)3) - PAINT_MARGIN_WORDS;
+    paint({paintLow, paintHigh});
+}
+
+/**
+ * @brief Measures the current breakdown.
+ *
+ * The heap may have grown into the painted region since begin(); the scan
+ * starts above it.
+ */
+MemStats::Report MemStats::report()
+{
+    RamMap map = ramMap();
+    Report report;
+    report.dataBytes = map.dataEnd - map.ramStart;
+    report.bssBytes = map.bssEnd - map.bssStart;
+    report.heapBytes = map.heapEnd - map.bssEnd;
+    report.totalBytes = map.stackTop - map.ramStart;
+
+    uint32_t *scanLow = reinterpret_cast<uint32_t *>(map.heapEnd);
+    if (paintLow == nullptr || scanLow >= paintHigh)
+    {
+        // Not painted, or the heap ate all of it: nothing is known to be free
+        report.headroomBytes = 0;
+    }
+    else
+    {
+        report.headroomBytes = untouchedBytes({scanLow > paintLow ? scanLow : paintLow, paintHigh});
+    }
+    report.stackPeakBytes = map.stackTop - map.heapEnd - report.headroomBytes;
+    return report;
+}
+
+/**
+ * @brief Prints the breakdown.
+ */
+void MemStats::print(Print &out)
+{
+    Report r = report();
+    out.print("ram ");
+    out.print(r.totalBytes);
+    out.print(" B: data ");
+    out.print(r.dataBytes);
+    out.print(", bss ");
+    out.print(r.bssBytes);
+    out.print(", heap ");
+    out.print(r.heapBytes);
+    out.print(", stack peak ");
+    out.print(r.stackPeakBytes);
+    out.print(", never used ");
+    out.println(r.headroomBytes);
+}
+
+/**
+ * @brief Logs the breakdown every MEM_REPORT_INTERVAL_MS, call once per loop().
+ */
+void MemStats::poll()
+{
+#if MEM_REPORT_INTERVAL_MS > 0
+    unsigned long now = millis();
+    if (now - lastReport < MEM_REPORT_INTERVAL_MS)
+        return;
+    lastReport = now;
+
+    Report r = report();
+    LOG_INFO(SYSTEM, MemoryReport, r.stackPeakBytes, r.headroomBytes, r.heapBytes);
+#endif
+}
@@ -0,0 +1,118 @@
+#include "Profiler.h"
+
+/**
+ * @brief Prints the non-empty buckets as "exponent:count" pairs.
+ */
+void Log2Histogram::print(Print &out) const
+{
+    for (uint8_t i = 0; i < BUCKETS; i++)
+    {
+        if (buckets[i] == 0)
+            continue;
+        out.print(' ');
+        out.print(i);
+        out.print(':');
+        out.print(buckets[i]);
+    }
+}
+
+#ifdef ENABLE_PROFILER
+
+namespace
+{
+    constexpr uint8_t ZONE_COUNT = static_cast<uint8_t>(ProfileZone::Count);
+
+    const char *const ZONE_NAMES[ZONE_COUNT] = {
+        "loop",
+        "runner",
+        "memory",
+        "escape",
+        "archery",
+        "timerLcd",
+        "whadda",
+        "rgbLed",
+    };
+
+    Profiler::ZoneStats zones[ZONE_COUNT];
+
+    // Prints a value right-aligned in a field of the given width.
+    void printPadded(Print &out, uint32_t value, uint8_t width)
+    {
+        uint8_t digits = 1;
+        for (uint32_t v = value; v >= 10; v /= 10)
+            digits++;
+        while (digits++ < width)
+            out.print(' ');
+        out.print(value);
+    }
+}
+
+/**
+ * @brief Starts the cycle counter and clears all statistics.
+ */
+void Profiler::begin()
+{
+    CycleCounter::begin();
+    reset();
+}
+
+/**
+ * @brief Clears all statistics.
+ */
+void Profiler::reset()
+{
+    for (ZoneStats &zone : zones)
+    {
+        zone = ZoneStats{};
+        zone.minCycles = UINT32_MAX;
+    }
+}
+
+/**
+ * @brief Adds one measurement to a zone.
+ *
+ * @param zone   The zone that was measured.
+ * @param cycles Duration in CPU cycles.
+ */
+void Profiler::record(ProfileZone zone, uint32_t cycles)
+{
+    ZoneStats &stats = zones[static_cast<uint8_t>(zone)];
+    stats.count++;
+    stats.totalCycles += cycles;
+    if (cycles < stats.minCycles)
+        stats.minCycles = cycles;
+    if (cycles > stats.maxCycles)
+        stats.maxCycles = cycles;
+    stats.histogram.add(cycles);
+}
+
+/**
+ * @brief Prints all zones as a compact table.
+ *
+ * Durations are in CPU cycles, the histogram lists log2(cycles):count pairs.
+ *
+ * @param out Stream to print to, usually Serial.
+ */
+void Profiler::dump(Print &out)
+{
+    out.println("zone          count        min        avg        max  log2 hist");
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+    {
+        const ZoneStats &stats = zones[i];
+        if (stats.count == 0)
+            continue;
+
+        out.print(ZONE_NAMES[i]);
+        for (size_t pad = strlen(ZONE_NAMES[i]); pad < 8; pad++)
+            out.print(' ');
+        printPadded(out, stats.count, 11);
+        printPadded(out, stats.minCycles, 11);
+        printPadded(out, (uint32_t)(stats.totalCycles / stats.count), 11);
+        printPadded(out, stats.maxCycles, 11);
+        out.print(' ');
+        stats.histogram.print(out);
+        out.println();
+    }
+}
+
+#endif // ENABLE_PROFILER
@@ -0,0 +1,130 @@
+#include "StallMonitor.h"
+
+#ifdef ENABLE_STALL_MONITOR
+
+#ifdef ENABLE_IWDG
+#include <IWatchdog.h>
+#endif
+
+namespace
+{
+    uint32_t budgetUs = StallMonitor::DEFAULT_BUDGET_US;
+    uint32_t tickStartUs = 0;
+    uint32_t tickStartMs = 0;
+
+    StallMonitor::StallRecord ring[StallMonitor::RING_SIZE];
+    uint8_t ringHead = 0; // Next slot to write
+    uint32_t totalStalls = 0;
+    uint32_t lastProgressMs = 0;  // End of the last iteration quicker than PROGRESS_ITERATION_US
+}
+
+/**
+ * @brief Sets the budget and starts the watchdog if enabled.
+ *
+ * @param budget Iterations longer than this (in microseconds) are recorded.
+ */
+void StallMonitor::begin(uint32_t budget)
+{
+    budgetUs = budget;
+    ringHead = 0;
+    totalStalls = 0;
+    lastProgressMs = millis();
+
+#ifdef ENABLE_IWDG
+    if (IWatchdog.isReset(true))
+    {
+        Serial.println("Watchdog reset detected");
+    }
+    IWatchdog.begin(WATCHDOG_TIMEOUT_US);
+#endif
+}
+
+/**
+ * @brief Marks the start of a loop() iteration.
+ */
+void StallMonitor::beginTick()
+{
+    tickStartUs = micros();
+    tickStartMs = millis();
+}
+
+/**
+ * @brief Marks the end of a loop() iteration and records it if it stalled.
+ *
+ * Reaching this point means the iteration made progress, which is the only
+ * place the watchdog gets petted during normal play. Once no iteration has
+ * been quicker than PROGRESS_ITERATION_US for PROGRESS_WINDOW_MS, it is no
+ * longer petted, so a loop that keeps running but is bogged down also resets
+ * the board. A single long iteration, such as a blocking melody, does not.
+ *
+ * @param game  Active challenge number.
+ * @param state Raw state of the active challenge.
+ */
+void StallMonitor::endTick(uint8_t game, uint8_t state)
+{
+    uint32_t duration = micros() - tickStartUs;
+
+    if (duration > budgetUs)
+    {
+        ring[ringHead] = {tickStartMs, duration, game, state};
+        ringHead = (ringHead + 1) % RING_SIZE;
+        totalStalls++;
+    }
+
+    uint32_t nowMs = millis();
+    if (duration <= PROGRESS_ITERATION_US)
+        lastProgressMs = nowMs;
+
+#ifdef ENABLE_IWDG
+    if (nowMs - lastProgressMs < PROGRESS_WINDOW_MS)
+        IWatchdog.reload();
+#endif
+}
+
+/**
+ * @brief Pets the watchdog from an intentional terminal loop (win/game over screens).
+ */
+void StallMonitor::idle()
+{
+#ifdef ENABLE_IWDG
+    IWatchdog.reload();
+#endif
+}
+
+/**
+ * @brief Total number of stalls since boot.
+ */
+uint32_t StallMonitor::stallCount()
+{
+    return totalStalls;
+}
+
+/**
+ * @brief Prints the recorded stalls, oldest first.
+ *
+ * One line per stall: start time, duration, challenge and its state value.
+ */
+void StallMonitor::dump(Print &out)
+{
+    out.print("stalls: ");
+    out.print(totalStalls);
+    out.print(" budget_us: ");
+    out.println(budgetUs);
+
+    uint8_t count = totalStalls < RING_SIZE ? totalStalls : RING_SIZE;
+    uint8_t index = (ringHead + RING_SIZE - count) % RING_SIZE;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const StallRecord &record = ring[index];
+        out.print(record.timestampMs);
+        out.print(" ms  ");
+        out.print(record.durationUs);
+        out.print(" us  game ");
+        out.print(record.game);
+        out.print(" state ");
+        out.println(record.state);
+        index = (index + 1) % RING_SIZE;
+    }
+}
+
+#endif // ENABLE_STALL_MONITOR
@@ -0,0 +1,6 @@
+#include "Stimulus.h"
+
+#ifdef ENABLE_STIMULUS
+bool Stimulus::active = false;
+Stimulus::Frame Stimulus::frame = {false, 0, 0};
+#endif
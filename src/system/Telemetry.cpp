@@ -0,0 +1,228 @@
+#include "Telemetry.h"
+#include "FlashRecordLog.h"
+#include "FlashLayout.h"
+#include "BinLog.h"
+#include "Crc32.h"
+#include "Log.h"
+#include "MemoryGame.h"
+#include "ArcheryChallenge.h"
+
+static_assert(Telemetry::MEMORY_LEVELS == MemoryGameConfig::MAX_LEVEL, "One error counter per memory level");
+static_assert(Telemetry::ARCHERY_ROUNDS == ArcheryConfig::TOTAL_ROUNDS, "One arrow counter per archery round");
+
+namespace
+{
+    FlashRecordLog sessionLog(FlashLayout::TELEMETRY_ADDR, FlashLayout::TELEMETRY_PAGES, FlashLayout::PAGE_BYTES,
+                              sizeof(Telemetry::SessionRecord));
+
+    Telemetry::SessionRecord current;
+    uint8_t currentChallenge = 0; // 0 while no session is running
+    unsigned long challengeStart = 0;
+    uint16_t lastSession = 0;
+
+    // Finished records not yet in flash, oldest at pendingHead
+    Telemetry::SessionRecord pending[Telemetry::RING_SIZE];
+    uint8_t pendingHead = 0;
+    uint8_t pendingCount = 0;
+
+    void addSaturated(uint8_t &counter)
+    {
+        if (counter < 0xFF)
+            counter++;
+    }
+
+    void closeChallenge()
+    {
+        if (currentChallenge < 1 || currentChallenge > Telemetry::CHALLENGES)
+            return;
+        uint32_t seconds = current.challengeSeconds[currentChallenge - 1] + (millis() - challengeStart) / 1000UL;
+        current.challengeSeconds[currentChallenge - 1] = seconds > 0xFFFF ? 0xFFFF : seconds;
+    }
+
+    /**
+     * @brief Writes pending records to flash, oldest first, keeps them on failure.
+     */
+    void flush()
+    {
+        while (pendingCount > 0)
+        {
+            if (!sessionLog.append(&pending[pendingHead]))
+            {
+                LOG_ERROR(SYSTEM, TelemetryWriteFailed, pendingCount);
+                return;
+            }
+            pendingHead = (pendingHead + 1) % Telemetry::RING_SIZE;
+            pendingCount--;
+        }
+    }
+}
+
+/**
+ * @brief Mounts the flash log and continues the session numbering.
+ */
+void Telemetry::begin()
+{
+    sessionLog.begin();
+
+    SessionRecord record;
+    uint16_t cursor = 0;
+    while (sessionLog.next(cursor, &record))
+    {
+        lastSession = record.session;
+    }
+}
+
+/**
+ * @brief Starts a new record.
+ *
+ * @param challenge First challenge of the session (1-based).
+ * @param resumed   The session continues from a checkpoint.
+ */
+void Telemetry::beginSession(uint8_t challenge, bool resumed)
+{
+    current = SessionRecord{};
+    current.session = ++lastSession;
+    current.outcome = static_cast<uint8_t>(Outcome::Running);
+    current.flags = resumed ? FLAG_RESUMED : 0;
+    currentChallenge = challenge;
+    challengeStart = millis();
+}
+
+/**
+ * @brief Closes the time of the previous challenge and starts timing the next one.
+ */
+void Telemetry::enterChallenge(uint8_t challenge)
+{
+    if (currentChallenge == 0)
+        return;
+    closeChallenge();
+    currentChallenge = challenge;
+    challengeStart = millis();
+}
+
+/**
+ * @brief Finishes the record and writes it to flash.
+ *
+ * If the ring is full because flash writes keep failing, the oldest
+ * pending record is dropped.
+ */
+void Telemetry::endSession(Outcome outcome)
+{
+    if (currentChallenge == 0)
+        return;
+    closeChallenge();
+    currentChallenge = 0;
+    current.outcome = static_cast<uint8_t>(outcome);
+
+    if (pendingCount == RING_SIZE)
+    {
+        pendingHead = (pendingHead + 1) % RING_SIZE;
+        pendingCount--;
+    }
+    pending[(pendingHead + pendingCount) % RING_SIZE] = current;
+    pendingCount++;
+    flush();
+}
+
+void Telemetry::runnerDied(unsigned long score)
+{
+    addSaturated(current.runnerDeaths);
+    if (score > current.runnerBestScore)
+        current.runnerBestScore = score > 0xFFFF ? 0xFFFF : score;
+}
+
+void Telemetry::memoryError(int level)
+{
+    if (level >= 1 && level <= MEMORY_LEVELS)
+        addSaturated(current.memoryErrors[level - 1]);
+}
+
+void Telemetry::escapeGateFailed()
+{
+    addSaturated(current.escapeGateFailures);
+}
+
+void Telemetry::escapeOutOfLives()
+{
+    addSaturated(current.escapeRestarts);
+}
+
+void Telemetry::archeryArrow(int round)
+{
+    if (round >= 1 && round <= ARCHERY_ROUNDS)
+        addSaturated(current.archeryArrows[round - 1]);
+}
+
+/**
+ * @brief Prints the number of stored and pending records.
+ */
+void Telemetry::printSummary(Print &out)
+{
+    SessionRecord record;
+    uint16_t cursor = 0;
+    uint16_t stored = 0;
+    while (sessionLog.next(cursor, &record))
+    {
+        stored++;
+    }
+
+    out.print(stored);
+    out.print(" sessions stored (room for ");
+    out.print(sessionLog.capacity());
+    out.print("), ");
+    out.print(pendingCount);
+    out.print(" pending, last session ");
+    out.println(lastSession);
+}
+
+/**
+ * @brief Writes every stored record as one binary frame.
+ *
+ * Frame: 'T' 'L' 'M' | version | uint16 count | uint16 record size |
+ * records, oldest first | CRC-32 over everything before it. Pending
+ * records that could not be written to flash are included at the end.
+ * The binary log is flushed first so its records do not interleave.
+ */
+void Telemetry::exportRecords(Print &out)
+{
+    SessionRecord record;
+    uint16_t cursor = 0;
+    uint16_t count = pendingCount;
+    while (sessionLog.next(cursor, &record))
+    {
+        count++;
+    }
+
+    BinLog::flush();
+
+    const uint8_t header[8] = {'T', 'L', 'M', EXPORT_VERSION,
+                               (uint8_t)count, (uint8_t)(count >> 8),
+                               (uint8_t)sizeof(SessionRecord), (uint8_t)(sizeof(SessionRecord) >> 8)};
+    out.write(header, sizeof(header));
+    uint32_t crc = Crc32::compute(header, sizeof(header));
+
+    cursor = 0;
+    while (sessionLog.next(cursor, &record))
+    {
+        out.write(reinterpret_cast<const uint8_t *>(&record), sizeof(record));
+        crc = Crc32::compute(reinterpret_cast<const uint8_t *>(&record), sizeof(record), crc);
+    }
+    for (uint8_t i = 0; i < pendingCount; i++)
+    {
+        const SessionRecord &entry = pending[(pendingHead + i) % RING_SIZE];
+        out.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry));
+        crc = Crc32::compute(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry), crc);
+    }
+
+    const uint8_t trailer[4] = {(uint8_t)crc, (uint8_t)(crc >> 8), (uint8_t)(crc >> 16), (uint8_t)(crc >> 24)};
+    out.write(trailer, sizeof(trailer));
+}
+
+/**
+ * @brief Erases the stored records.
+ */
+bool Telemetry::clear()
+{
+    pendingCount = 0;
+    return sessionLog.clear();
+}
@@ -0,0 +1,136 @@
+#include "Tuning.h"
+#include "FlashKvStore.h"
+#include "FlashLayout.h"
+#include "Log.h"
+
+#include "Globals.h"
+#include "RunnerGame.h"
+#include "MemoryGame.h"
+#include "EscapeVelocity.h"
+#include "ArcheryChallenge.h"
+
+TuningConfig tuning;
+
+namespace
+{
+    struct Param
+    {
+        TuningKey key;
+        const char *name;
+        int32_t TuningConfig::*field;
+        int32_t defaultValue;
+        int32_t minValue;
+        int32_t maxValue;
+    };
+
+#define TUNING_PARAM(id, field, defaultValue, minValue, maxValue) \
+    {TuningKey::id, #id, &TuningConfig::field, (int32_t)(defaultValue), (int32_t)(minValue), (int32_t)(maxValue)}
+
+    const Param PARAMS[] = {
+        TUNING_PARAM(GameDurationMs, gameDurationMs, GAME_DURATION, 60000UL, 3600000UL),
+        TUNING_PARAM(RunnerWinTimeMs, runnerWinTimeMs, RunnerGameConfig::WIN_TIME, 5000, 600000UL),
+        TUNING_PARAM(RunnerSpeedFactorPermille, runnerSpeedFactorPermille, RunnerGameConfig::SPEED_INCREASE_PERMILLE, 500, 1000),
+        TUNING_PARAM(MemoryMaxLevel, memoryMaxLevel, MemoryGameConfig::MAX_LEVEL, 1, MemoryGameConfig::MAX_LEVEL),
+        TUNING_PARAM(EscapeInRangeMs, escapeInRangeMs, EscVelocityConfig::IN_RANGE_MS, 500, EscVelocityConfig::GATE_TIME_MS - 1000),
+        TUNING_PARAM(EscapeTolerance, escapeTolerance, EscVelocityConfig::TOLERANCE, 0, 100),
+        TUNING_PARAM(ArcheryToleranceRound1, archeryToleranceRound1, ArcheryConfig::TOLERANCE_ROUND1, 5, 500),
+        TUNING_PARAM(ArcheryToleranceRound2, archeryToleranceRound2, ArcheryConfig::TOLERANCE_ROUND2, 5, 500),
+        TUNING_PARAM(ArcheryToleranceRound3, archeryToleranceRound3, ArcheryConfig::TOLERANCE_ROUND3, 5, 500),
+        TUNING_PARAM(RunnerJumpBufferMs, runnerJumpBufferMs, RunnerGameConfig::JUMP_BUFFER_MS, 0, 500),
+        TUNING_PARAM(RunnerCoyoteMs, runnerCoyoteMs, RunnerGameConfig::COYOTE_TIME_MS, 0, RunnerGameConfig::MIN_GAME_INTERVAL - 1),
+        TUNING_PARAM(MemoryAppendMode, memoryAppendMode, MemoryGameConfig::APPEND_MODE, 0, 1),
+        TUNING_PARAM(MemoryTempoMinPercent, memoryTempoMinPercent, MemoryGameConfig::TEMPO_MIN_PERCENT, 25, 100),
+        TUNING_PARAM(MemoryTempoMaxPercent, memoryTempoMaxPercent, MemoryGameConfig::TEMPO_MAX_PERCENT, 100, 300),
+        TUNING_PARAM(MemoryChordWindowMs, memoryChordWindowMs, MemoryGameConfig::CHORD_WINDOW_MS, 0, 100),
+    };
+
+#undef TUNING_PARAM
+
+    FlashKvStore configStore(FlashLayout::CONFIG_ADDR, FlashLayout::CONFIG_PAGES, FlashLayout::PAGE_BYTES);
+    bool storeReady = false;
+
+    const Param *find(TuningKey key)
+    {
+        for (const Param &param : PARAMS)
+        {
+            if (param.key == key)
+                return &param;
+        }
+        return nullptr;
+    }
+
+    void apply(const Param &param, int32_t value)
+    {
+        if (value < param.minValue || value > param.maxValue)
+        {
+            LOG_WARN(SYSTEM, TuningRejected, static_cast<uint16_t>(param.key), value);
+            return;
+        }
+        tuning.*param.field = value;
+    }
+}
+
+/**
+ * @brief Fills in the tuning struct: defaults, then asset pack, then config store.
+ */
+void Tuning::load()
+{
+    storeReady = configStore.begin();
+    if (!storeReady)
+        LOG_ERROR(SYSTEM, ConfigStoreFailed);
+
+    for (const Param &param : PARAMS)
+    {
+        tuning.*param.field = param.defaultValue;
+
+        int32_t value;
+        if (Assets::tuning(param.key, value))
+            apply(param, value);
+        if (storeReady && configStore.read(static_cast<uint16_t>(param.key), value))
+            apply(param, value);
+    }
+}
+
+/**
+ * @brief Persists a parameter in the config store, then puts it in effect.
+ *
+ * The value only changes once it is in flash, so what runs always matches
+ * what the next boot loads. It takes effect immediately; games that cache a
+ * value pick it up on their next restart.
+ */
+Tuning::SetResult Tuning::set(TuningKey key, int32_t value)
+{
+    const Param *param = find(key);
+    if (param == nullptr || value < param->minValue || value > param->maxValue)
+        return SetResult::Invalid;
+
+    if (!storeReady || !configStore.write(static_cast<uint16_t>(key), value))
+        return SetResult::StoreFailed;
+
+    tuning.*param->field = value;
+    return SetResult::Saved;
+}
+
+/**
+ * @brief Prints every parameter with its current value.
+ */
+void Tuning::print(Print &out)
+{
+    for (const Param &param : PARAMS)
+    {
+        out.print(static_cast<uint16_t>(param.key));
+        out.print(' ');
+        out.print(param.name);
+        out.print(" = ");
+        out.print(tuning.*param.field);
+        out.print(" [");
+        out.print(param.minValue);
+        out.print("..");
+        out.print(param.maxValue);
+        out.println(']');
+    }
+    out.print("config store generation ");
+    out.print(configStore.generation());
+    out.print(", free records ");
+    out.println(configStore.freeRecords());
+}
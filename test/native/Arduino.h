@@ -0,0 +1,109 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host stand-in for the parts of the Arduino core that the modules under
+// test use (env:native). Time only moves when a test sets HostArduino::microsNow.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+
+namespace HostArduino
+{
+    inline unsigned long microsNow = 0;
+}
+
+inline unsigned long micros()
+{
+    return HostArduino::microsNow;
+}
+
+inline unsigned long millis()
+{
+    return HostArduino::microsNow / 1000;
+}
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t byte) = 0;
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+            write(buffer[i]);
+        return size;
+    }
+
+    size_t print(const char *text) { return write(reinterpret_cast<const uint8_t *>(text), strlen(text)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+
+    size_t print(long value, int base = DEC)
+    {
+        if (base != DEC)
+            return print((unsigned long)value, base);
+        char text[24];
+        snprintf(text, sizeof(text), "%ld", value);
+        return print(text);
+    }
+
+    size_t print(unsigned long value, int base = DEC)
+    {
+        char text[24];
+        snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+        return print(text);
+    }
+
+    size_t println() { return print("\r\n"); }
+
+    template <typename T>
+    size_t println(T value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+};
+
+#define SERIAL_TX_BUFFER_SIZE 64
+
+/**
+ * @brief Serial port that keeps the start of its output for inspection.
+ *
+ * room stands in for the free space in the transmit buffer: every byte
+ * written takes one, and a test gives it back to model the UART sending.
+ */
+class HostSerial : public Print
+{
+public:
+    static constexpr size_t CAPTURE_BYTES = 4096;
+
+    uint8_t captured[CAPTURE_BYTES];
+    size_t capturedLength = 0;
+    int room = SERIAL_TX_BUFFER_SIZE - 1;
+
+    using Print::write;
+
+    size_t write(uint8_t byte) override
+    {
+        if (capturedLength < CAPTURE_BYTES)
+            captured[capturedLength++] = byte;
+        if (room > 0)
+            room--;
+        return 1;
+    }
+
+    int availableForWrite() { return room; }
+    void flush() {}
+};
+
+inline HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
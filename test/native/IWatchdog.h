@@ -0,0 +1,27 @@
+#ifndef HOST_IWATCHDOG_H
+#define HOST_IWATCHDOG_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Host stand-in for the STM32 core's IWatchdog (env:native): counts the reloads
+// and keeps the micros() of the last one
+class IWatchdogClass
+{
+public:
+    uint32_t timeoutUs = 0;
+    uint32_t reloads = 0;
+    unsigned long lastReloadUs = 0;
+
+    void begin(uint32_t timeout) { timeoutUs = timeout; }
+    bool isReset(bool = false) { return false; }
+    void reload()
+    {
+        reloads++;
+        lastReloadUs = HostArduino::microsNow;
+    }
+};
+
+inline IWatchdogClass IWatchdog;
+
+#endif // HOST_IWATCHDOG_H
@@ -0,0 +1,219 @@
+#include <Arduino.h>
+#include <limits.h>
+#include <unity.h>
+
+#include "BinLog.h"
+
+// Draining the ring into a transmit buffer with limited room, checked with a
+// decoder that follows tools/binlog_decode.py
+
+namespace
+{
+    constexpr uint8_t BATCH_RECORDS = 5;
+
+    struct Record
+    {
+        uint8_t format;
+        uint32_t timestamp;
+        int32_t args[BinLog::MAX_ARGS];
+        uint8_t argc;
+    };
+
+    /**
+     * @brief Logs a fixed mix of record sizes, from no arguments to MAX_ARGS five-byte varints.
+     */
+    void logBatch(int32_t first)
+    {
+        BinLog::log(LogFormat::EscapeCompleted);
+        BinLog::log(LogFormat::EscapeGateFailed, first);
+        BinLog::log(LogFormat::EscapeGateRange, first, -200, 70000);
+        BinLog::log(LogFormat::ArcheryArrow, INT32_MIN, INT32_MAX);
+        BinLog::log(LogFormat::MemorySequence, first, INT32_MIN, -1, INT32_MAX, 0);
+    }
+
+    /**
+     * @brief Empties the ring and the captured output.
+     */
+    void resetLog()
+    {
+        Serial.room = BinLog::RING_SIZE;
+        BinLog::flush();
+        Serial.capturedLength = 0;
+    }
+
+    bool readVarint(const uint8_t *data, size_t end, size_t &pos, uint32_t &value)
+    {
+        value = 0;
+        for (uint8_t shift = 0; pos < end && shift < 35; shift += 7)
+        {
+            uint8_t byte = data[pos++];
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Decodes the record at pos, which has to end before end.
+     *
+     * @return false for a partial or corrupt record, which the decoder would drop.
+     */
+    bool decodeRecord(const uint8_t *data, size_t end, size_t &pos, Record &record)
+    {
+        if (end - pos < 4 || data[pos] != BinLog::SYNC)
+            return false;
+        size_t payloadEnd = pos + 3 + data[pos + 2];
+        if (payloadEnd >= end)
+            return false;
+
+        uint8_t checksum = 0;
+        for (size_t i = pos + 1; i < payloadEnd; i++)
+            checksum += data[i];
+        if (checksum != data[payloadEnd])
+            return false;
+
+        record.format = data[pos + 1];
+        size_t p = pos + 3;
+        if (!readVarint(data, payloadEnd, p, record.timestamp))
+            return false;
+        record.argc = 0;
+        while (p < payloadEnd)
+        {
+            uint32_t zigzag;
+            if (record.argc == BinLog::MAX_ARGS || !readVarint(data, payloadEnd, p, zigzag))
+                return false;
+            record.args[record.argc++] = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+        }
+        pos = payloadEnd + 1;
+        return true;
+    }
+
+    /**
+     * @brief Checks a record against the one logged by logBatch(first) at the given index.
+     */
+    void checkBatchRecord(const Record &record, uint8_t index, int32_t first)
+    {
+        static const LogFormat formats[BATCH_RECORDS] = {
+            LogFormat::EscapeCompleted, LogFormat::EscapeGateFailed, LogFormat::EscapeGateRange,
+            LogFormat::ArcheryArrow, LogFormat::MemorySequence};
+        static const uint8_t argcs[BATCH_RECORDS] = {0, 1, 3, 2, 5};
+
+        TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(formats[index]), record.format);
+        TEST_ASSERT_EQUAL_UINT8(argcs[index], record.argc);
+        TEST_ASSERT_EQUAL_UINT32(millis(), record.timestamp);
+        if (index == 1 || index == 2 || index == 4)
+            TEST_ASSERT_EQUAL_INT32(first, record.args[0]);
+        if (index == 3)
+        {
+            TEST_ASSERT_EQUAL_INT32(INT32_MIN, record.args[0]);
+            TEST_ASSERT_EQUAL_INT32(INT32_MAX, record.args[1]);
+        }
+    }
+}
+
+void setUp()
+{
+    HostArduino::microsNow = 123456789; // Four-byte varint timestamp
+    resetLog();
+}
+
+void tearDown() {}
+
+// Whatever room the transmit buffer has, exactly the records that fit go out
+void test_drain_sends_only_whole_records()
+{
+    logBatch(7);
+    BinLog::flush();
+    size_t ends[BATCH_RECORDS];
+    size_t pos = 0;
+    for (uint8_t i = 0; i < BATCH_RECORDS; i++)
+    {
+        Record record;
+        TEST_ASSERT_TRUE(decodeRecord(Serial.captured, Serial.capturedLength, pos, record));
+        checkBatchRecord(record, i, 7);
+        ends[i] = pos;
+    }
+    TEST_ASSERT_EQUAL_size_t(Serial.capturedLength, pos);
+
+    for (int room = 0; room < SERIAL_TX_BUFFER_SIZE; room++)
+    {
+        resetLog();
+        logBatch(7);
+        Serial.room = room;
+        BinLog::drain();
+
+        size_t expected = 0;
+        for (uint8_t i = 0; i < BATCH_RECORDS && ends[i] <= (size_t)room; i++)
+            expected = ends[i];
+        TEST_ASSERT_EQUAL_size_t(expected, Serial.capturedLength);
+    }
+}
+
+// Console text printed between drains stays between records
+void test_text_between_drains_never_splits_a_record()
+{
+    constexpr uint8_t BATCHES = 6;
+    for (uint8_t batch = 0; batch < BATCHES; batch++)
+        logBatch(batch);
+
+    for (int step = 0; step < 200; step++)
+    {
+        Serial.room = 3 + step % 29;
+        BinLog::drain();
+        Serial.print("> ok\r\n");
+    }
+
+    uint16_t records = 0;
+    size_t pos = 0;
+    while (pos < Serial.capturedLength)
+    {
+        if (Serial.captured[pos] != BinLog::SYNC)
+        {
+            TEST_ASSERT_TRUE(Serial.captured[pos] < 0x80);
+            pos++;
+            continue;
+        }
+        Record record;
+        TEST_ASSERT_TRUE(decodeRecord(Serial.captured, Serial.capturedLength, pos, record));
+        checkBatchRecord(record, records % BATCH_RECORDS, records / BATCH_RECORDS);
+        records++;
+    }
+    TEST_ASSERT_EQUAL_UINT16(BATCHES * BATCH_RECORDS, records);
+}
+
+// Records that straddle the end of the ring come out in one piece
+void test_records_wrapping_the_ring_arrive_intact()
+{
+    constexpr int32_t BATCHES = 40; // Several times around the ring
+    int32_t logged = 0;
+    size_t pos = 0;
+    uint16_t records = 0;
+
+    // A batch every third drain keeps the ring from filling up
+    for (int step = 0; records < BATCHES * BATCH_RECORDS; step++)
+    {
+        if (step % 3 == 0 && logged < BATCHES)
+            logBatch(logged++);
+        Serial.room = 50;
+        BinLog::drain();
+
+        while (pos < Serial.capturedLength)
+        {
+            Record record;
+            TEST_ASSERT_TRUE(decodeRecord(Serial.captured, Serial.capturedLength, pos, record));
+            checkBatchRecord(record, records % BATCH_RECORDS, records / BATCH_RECORDS);
+            records++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, BinLog::droppedCount());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_drain_sends_only_whole_records);
+    RUN_TEST(test_text_between_drains_never_splits_a_record);
+    RUN_TEST(test_records_wrapping_the_ring_arrive_intact);
+    return UNITY_END();
+}
@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <unity.h>
+
+#include "CostHistogram.h"
+
+// Bucket maths of the soak tick-cost histogram
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_small_values_have_a_bucket_each()
+{
+    for (uint32_t us = 0; us < 4; us++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(us, CostHistogram::bucketFor(us));
+        TEST_ASSERT_EQUAL_UINT32(us, CostHistogram::lowerBound(us));
+    }
+}
+
+void test_bucket_bounds_round_trip()
+{
+    for (uint8_t bucket = 0; bucket + 1 < CostHistogram::BUCKETS; bucket++)
+    {
+        uint32_t low = CostHistogram::lowerBound(bucket);
+        uint32_t next = CostHistogram::lowerBound(bucket + 1);
+        TEST_ASSERT_GREATER_THAN_UINT32(low, next);
+        TEST_ASSERT_EQUAL_UINT8(bucket, CostHistogram::bucketFor(low));
+        TEST_ASSERT_EQUAL_UINT8(bucket, CostHistogram::bucketFor(next - 1));
+    }
+}
+
+void test_buckets_are_at_most_a_quarter_wide()
+{
+    for (uint8_t bucket = 4; bucket + 1 < CostHistogram::BUCKETS; bucket++)
+    {
+        uint32_t low = CostHistogram::lowerBound(bucket);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(low / 4, CostHistogram::lowerBound(bucket + 1) - low);
+    }
+}
+
+void test_largest_value_lands_in_the_top_bucket()
+{
+    TEST_ASSERT_EQUAL_UINT8(CostHistogram::BUCKETS - 1, CostHistogram::bucketFor(UINT32_MAX));
+    TEST_ASSERT_EQUAL_UINT8(CostHistogram::BUCKETS - 1, CostHistogram::bucketFor(CostHistogram::lowerBound(CostHistogram::BUCKETS - 1)));
+}
+
+void test_percentiles_are_within_a_quarter()
+{
+    CostHistogram histogram{};
+    for (uint32_t us = 1; us <= 1000; us++)
+        histogram.add(us);
+
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.total);
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.maxUs);
+
+    uint32_t median = histogram.percentile(500);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(500, median);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(625, median);
+
+    uint32_t p99 = histogram.percentile(990);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(990, p99);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(990 + 990 / 4, p99);
+}
+
+void test_empty_histogram_reports_zero()
+{
+    CostHistogram histogram{};
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.percentile(500));
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.percentile(1000));
+}
+
+void test_top_bucket_reports_the_maximum()
+{
+    CostHistogram histogram{};
+    histogram.add(10);
+    histogram.add(0xF0000001);
+
+    TEST_ASSERT_EQUAL_UINT32(0xF0000001, histogram.percentile(1000));
+    TEST_ASSERT_EQUAL_UINT32(11, histogram.percentile(500));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_small_values_have_a_bucket_each);
+    RUN_TEST(test_bucket_bounds_round_trip);
+    RUN_TEST(test_buckets_are_at_most_a_quarter_wide);
+    RUN_TEST(test_largest_value_lands_in_the_top_bucket);
+    RUN_TEST(test_percentiles_are_within_a_quarter);
+    RUN_TEST(test_empty_histogram_reports_zero);
+    RUN_TEST(test_top_bucket_reports_the_maximum);
+    return UNITY_END();
+}
@@ -0,0 +1,193 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "FlashDriver.h"
+#include "FlashKvStore.h"
+#include "FlashLayout.h"
+
+namespace
+{
+    constexpr uint8_t PAGES = 2;
+    constexpr uint32_t FLASH_BYTES = PAGES * FlashLayout::PAGE_BYTES;
+    constexpr uint8_t KEYS = 4;
+    constexpr uint16_t WRITES = 600; // A bit over two page rotations
+
+    uint32_t flash[FLASH_BYTES / 4];
+    uint32_t image[FLASH_BYTES / 4];
+
+    // Latest value per key (index key - 1) and whether it was ever written
+    int32_t model[KEYS];
+    bool written[KEYS];
+
+    FlashKvStore makeStore()
+    {
+        return FlashKvStore((uintptr_t)flash, PAGES, FlashLayout::PAGE_BYTES);
+    }
+
+    uint16_t keyOf(uint16_t step)
+    {
+        return 1 + step % KEYS;
+    }
+
+    int32_t valueOf(uint16_t step)
+    {
+        return (int32_t)step * 7919 - 100000;
+    }
+
+    // Boots a fresh store from the flash contents and checks every key against the model.
+    // The key being written may hold either its old or its new value.
+    void checkAfterReboot(uint16_t writingKey, int32_t newValue, uint32_t cut)
+    {
+        FlashKvStore store = makeStore();
+        TEST_ASSERT_TRUE(store.begin());
+
+        char message[64];
+        for (uint16_t key = 1; key <= KEYS; key++)
+        {
+            int32_t value = 0;
+            bool found = store.read(key, value);
+            bool isOld = found ? written[key - 1] && value == model[key - 1] : !written[key - 1];
+            bool isNew = key == writingKey && found && value == newValue;
+            snprintf(message, sizeof(message), "key %u after a cut at operation %lu", key, (unsigned long)cut);
+            TEST_ASSERT_TRUE_MESSAGE(isOld || isNew, message);
+        }
+    }
+}
+
+void setUp()
+{
+    FlashDriver::Sim::restorePower();
+    memset(flash, 0xFF, sizeof(flash));
+    memset(written, 0, sizeof(written));
+}
+
+void tearDown()
+{
+    FlashDriver::Sim::restorePower();
+}
+
+void test_values_survive_a_reboot()
+{
+    FlashKvStore store = makeStore();
+    TEST_ASSERT_TRUE(store.begin());
+    for (uint16_t step = 0; step < WRITES; step++)
+        TEST_ASSERT_TRUE(store.write(keyOf(step), valueOf(step)));
+    TEST_ASSERT_EQUAL_UINT16(2, store.generation());
+
+    FlashKvStore rebooted = makeStore();
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL_UINT16(2, rebooted.generation());
+    for (uint16_t step = WRITES - KEYS; step < WRITES; step++)
+    {
+        int32_t value = 0;
+        TEST_ASSERT_TRUE(rebooted.read(keyOf(step), value));
+        TEST_ASSERT_EQUAL_INT32(valueOf(step), value);
+    }
+}
+
+// A first boot that loses power while formatting formats again on the next boot
+void test_power_cut_while_formatting()
+{
+    for (uint32_t cut = 0;; cut++)
+    {
+        memset(flash, 0xFF, sizeof(flash));
+        FlashDriver::Sim::cutPowerAfter(cut);
+        FlashKvStore store = makeStore();
+        bool formatted = store.begin();
+        bool lost = FlashDriver::Sim::powerLost();
+        FlashDriver::Sim::restorePower();
+
+        checkAfterReboot(0, 0, cut);
+        if (!lost)
+        {
+            TEST_ASSERT_TRUE(formatted);
+            break;
+        }
+    }
+}
+
+// Cuts the power at every operation of every write, page rotations included,
+// and reboots: each key must read back its old or its new value, never a torn one
+void test_every_power_cut_leaves_old_or_new_value()
+{
+    FlashKvStore store = makeStore();
+    TEST_ASSERT_TRUE(store.begin());
+
+    uint32_t cuts = 0;
+    for (uint16_t step = 0; step < WRITES; step++)
+    {
+        uint16_t key = keyOf(step);
+        int32_t value = valueOf(step);
+        memcpy(image, flash, sizeof(flash));
+
+        for (uint32_t cut = 0;; cut++)
+        {
+            memcpy(flash, image, sizeof(flash));
+            FlashKvStore interrupted = makeStore();
+            TEST_ASSERT_TRUE(interrupted.begin());
+
+            FlashDriver::Sim::cutPowerAfter(cut);
+            bool stored = interrupted.write(key, value);
+            bool lost = FlashDriver::Sim::powerLost();
+            FlashDriver::Sim::restorePower();
+
+            checkAfterReboot(key, value, cut);
+            if (!lost)
+            {
+                TEST_ASSERT_TRUE(stored);
+                break;
+            }
+            cuts++;
+        }
+
+        model[key - 1] = value;
+        written[key - 1] = true;
+        checkAfterReboot(0, 0, 0);
+    }
+
+    FlashKvStore rebooted = makeStore();
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL_UINT16(2, rebooted.generation());
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(WRITES * 4, cuts);
+}
+
+// Tuning::set relies on a failed write reporting false and leaving the old
+// value readable, both on the running store and after a reboot
+void test_failed_write_keeps_the_old_value()
+{
+    for (uint32_t cut = 0; cut < 3; cut++)
+    {
+        memset(flash, 0xFF, sizeof(flash));
+        FlashKvStore store = makeStore();
+        TEST_ASSERT_TRUE(store.begin());
+        TEST_ASSERT_TRUE(store.write(1, 10));
+
+        FlashDriver::Sim::cutPowerAfter(cut);
+        TEST_ASSERT_FALSE(store.write(1, 20));
+        FlashDriver::Sim::restorePower();
+
+        int32_t value = 0;
+        TEST_ASSERT_TRUE(store.read(1, value));
+        TEST_ASSERT_EQUAL_INT32(10, value);
+
+        FlashKvStore rebooted = makeStore();
+        TEST_ASSERT_TRUE(rebooted.begin());
+        TEST_ASSERT_TRUE(rebooted.read(1, value));
+        TEST_ASSERT_EQUAL_INT32(10, value);
+
+        // The failed slot is skipped, the next write still lands
+        TEST_ASSERT_TRUE(store.write(1, 30));
+        TEST_ASSERT_TRUE(store.read(1, value));
+        TEST_ASSERT_EQUAL_INT32(30, value);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_values_survive_a_reboot);
+    RUN_TEST(test_power_cut_while_formatting);
+    RUN_TEST(test_every_power_cut_leaves_old_or_new_value);
+    RUN_TEST(test_failed_write_keeps_the_old_value);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "Fmt.h"
+
+// The display formatters against snprintf() on the saturated value
+
+namespace
+{
+    const uint32_t UNSIGNED_VALUES[] = {
+        0, 1, 7, 9, 10, 42, 99, 100, 999, 1000, 9999, 10000, 65535, 99999, 100000,
+        999999, 1000000, 9999999, 10000000, 99999999, 100000000, 999999999,
+        1000000000, 2147483647u, 2147483648u, 4000000000u, 4294967294u, UINT32_MAX};
+
+    const int32_t SIGNED_VALUES[] = {
+        0, 1, -1, 9, -9, 10, -10, 42, -42, 99, -99, 100, -100, 999, -999, 1000, -1000,
+        99999, -99999, 100000000, -100000000, 999999999, -999999999, 1000000000,
+        -1000000000, INT32_MAX, INT32_MIN + 1, INT32_MIN};
+
+    // Fills the bytes around a field so a write past WIDTH shows up
+    constexpr char GUARD = '#';
+
+    template <uint8_t WIDTH>
+    void checkUnsigned(uint32_t value, char pad)
+    {
+        uint32_t shown = value > Fmt::maxValue(WIDTH) ? Fmt::maxValue(WIDTH) : value;
+        char expected[16];
+        snprintf(expected, sizeof(expected), pad == '0' ? "%0*lu" : "%*lu", WIDTH, (unsigned long)shown);
+
+        char out[WIDTH + 2];
+        memset(out, GUARD, sizeof(out));
+        Fmt::writeUnsigned<WIDTH>(out, value, pad);
+        TEST_ASSERT_EQUAL_INT(GUARD, out[WIDTH]);
+        out[WIDTH] = '\0';
+
+        char message[48];
+        snprintf(message, sizeof(message), "%lu in width %u pad '%c'", (unsigned long)value, WIDTH, pad);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, out, message);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Fmt::unsignedField<WIDTH>(value, pad).text, message);
+        if (pad == '0')
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Fmt::zeroPadded<WIDTH>(value).text, message);
+    }
+
+    template <uint8_t WIDTH>
+    void checkSigned(int32_t value, char pad)
+    {
+        // Negative values keep a column for the sign
+        int64_t highest = Fmt::maxValue(WIDTH);
+        int64_t lowest = -(int64_t)Fmt::maxValue(WIDTH - 1);
+        int64_t shown = value > highest ? highest : (value < lowest ? lowest : value);
+        char expected[16];
+        snprintf(expected, sizeof(expected), pad == '0' ? "%0*lld" : "%*lld", WIDTH, (long long)shown);
+
+        char out[WIDTH + 2];
+        memset(out, GUARD, sizeof(out));
+        Fmt::writeSigned<WIDTH>(out, value, pad);
+        TEST_ASSERT_EQUAL_INT(GUARD, out[WIDTH]);
+        out[WIDTH] = '\0';
+
+        char message[48];
+        snprintf(message, sizeof(message), "%ld in width %u pad '%c'", (long)value, WIDTH, pad);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, out, message);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Fmt::signedField<WIDTH>(value, pad).text, message);
+    }
+
+    template <uint8_t WIDTH>
+    void checkUnsignedWidth()
+    {
+        for (uint32_t value : UNSIGNED_VALUES)
+        {
+            checkUnsigned<WIDTH>(value, ' ');
+            checkUnsigned<WIDTH>(value, '0');
+        }
+    }
+
+    template <uint8_t WIDTH>
+    void checkSignedWidth()
+    {
+        for (int32_t value : SIGNED_VALUES)
+        {
+            checkSigned<WIDTH>(value, ' ');
+            checkSigned<WIDTH>(value, '0');
+        }
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_max_value_and_digit_count()
+{
+    TEST_ASSERT_EQUAL_UINT32(0, Fmt::maxValue(0));
+    TEST_ASSERT_EQUAL_UINT32(9, Fmt::maxValue(1));
+    TEST_ASSERT_EQUAL_UINT32(999999999, Fmt::maxValue(9));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, Fmt::maxValue(10));
+
+    char text[16];
+    for (uint32_t value : UNSIGNED_VALUES)
+    {
+        snprintf(text, sizeof(text), "%lu", (unsigned long)value);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(strlen(text), Fmt::digitCount(value), text);
+    }
+}
+
+// Every width, space and zero padding, values that fit and values that saturate
+void test_unsigned_matches_snprintf()
+{
+    checkUnsignedWidth<1>();
+    checkUnsignedWidth<2>();
+    checkUnsignedWidth<3>();
+    checkUnsignedWidth<4>();
+    checkUnsignedWidth<5>();
+    checkUnsignedWidth<6>();
+    checkUnsignedWidth<7>();
+    checkUnsignedWidth<8>();
+    checkUnsignedWidth<9>();
+    checkUnsignedWidth<10>();
+}
+
+void test_signed_matches_snprintf()
+{
+    checkSignedWidth<2>();
+    checkSignedWidth<3>();
+    checkSignedWidth<4>();
+    checkSignedWidth<5>();
+    checkSignedWidth<6>();
+    checkSignedWidth<7>();
+    checkSignedWidth<8>();
+    checkSignedWidth<9>();
+    checkSignedWidth<10>();
+}
+
+// Saturation is visible as all nines rather than cut digits
+void test_overflow_saturates_instead_of_truncating()
+{
+    TEST_ASSERT_EQUAL_STRING("999", Fmt::unsignedField<3>(1000).text);
+    TEST_ASSERT_EQUAL_STRING("99", Fmt::zeroPadded<2>(123).text);
+    TEST_ASSERT_EQUAL_STRING("4294967295", Fmt::unsignedField<10>(UINT32_MAX).text);
+    TEST_ASSERT_EQUAL_STRING("-99", Fmt::signedField<3>(-100).text);
+    TEST_ASSERT_EQUAL_STRING("-999999999", Fmt::signedField<10>(INT32_MIN).text);
+    TEST_ASSERT_EQUAL_STRING("-999999999", Fmt::signedField<10>(INT32_MIN, '0').text);
+    TEST_ASSERT_EQUAL_STRING("2147483647", Fmt::signedField<10>(INT32_MAX).text);
+}
+
+void test_minutes_seconds_matches_snprintf()
+{
+    const uint32_t SECONDS[] = {
+        0, 1, 59, 60, 61, 599, 600, 3599, 3600, 5999, 5940, 5959, 6000, 6001,
+        59999, 360000, UINT32_MAX - 1, UINT32_MAX};
+
+    for (uint32_t seconds : SECONDS)
+    {
+        uint32_t minutes = seconds / 60;
+        uint32_t rest = seconds % 60;
+        if (minutes > 99)
+        {
+            minutes = 99;
+            rest = 59;
+        }
+        char expected[16];
+        snprintf(expected, sizeof(expected), "%02lu:%02lu", (unsigned long)minutes, (unsigned long)rest);
+
+        char out[7];
+        memset(out, GUARD, sizeof(out));
+        Fmt::writeMinutesSeconds(out, seconds);
+        TEST_ASSERT_EQUAL_INT(GUARD, out[5]);
+        out[5] = '\0';
+
+        char message[24];
+        snprintf(message, sizeof(message), "%lu s", (unsigned long)seconds);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, out, message);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Fmt::minutesSeconds(seconds).text, message);
+    }
+}
+
+// A hundred minutes or more shows 99:59, not a cut-off 00:00
+void test_minutes_from_one_hundred_saturate()
+{
+    TEST_ASSERT_EQUAL_STRING("99:59", Fmt::minutesSeconds(99 * 60 + 59).text);
+    TEST_ASSERT_EQUAL_STRING("99:59", Fmt::minutesSeconds(100 * 60).text);
+    TEST_ASSERT_EQUAL_STRING("99:59", Fmt::minutesSeconds(100 * 60 + 30).text);
+    TEST_ASSERT_EQUAL_STRING("99:59", Fmt::minutesSeconds(UINT32_MAX).text);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_max_value_and_digit_count);
+    RUN_TEST(test_unsigned_matches_snprintf);
+    RUN_TEST(test_signed_matches_snprintf);
+    RUN_TEST(test_overflow_saturates_instead_of_truncating);
+    RUN_TEST(test_minutes_seconds_matches_snprintf);
+    RUN_TEST(test_minutes_from_one_hundred_saturate);
+    return UNITY_END();
+}
@@ -0,0 +1,98 @@
+#include <Arduino.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unity.h>
+
+#include "HeapGuard.h"
+
+// Allocation counting through the link-time malloc wrappers of env:native
+
+namespace
+{
+    // Keeps the compiler from dropping allocations whose result is unused
+    void *volatile sink;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_malloc_and_free_are_counted()
+{
+    HeapGuard::Stats before = HeapGuard::stats();
+
+    void *block = malloc(100);
+    sink = block;
+    HeapGuard::Stats allocated = HeapGuard::stats();
+    TEST_ASSERT_EQUAL_UINT32(before.allocations + 1, allocated.allocations);
+    TEST_ASSERT_EQUAL_UINT32(before.bytesRequested + 100, allocated.bytesRequested);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(before.bytesInUse + 100, allocated.bytesInUse);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(allocated.bytesInUse, allocated.peakBytesInUse);
+
+    free(block);
+    HeapGuard::Stats freed = HeapGuard::stats();
+    TEST_ASSERT_EQUAL_UINT32(before.frees + 1, freed.frees);
+    TEST_ASSERT_EQUAL_UINT32(before.bytesInUse, freed.bytesInUse);
+    TEST_ASSERT_EQUAL_UINT32(0, freed.lockedAllocations);
+}
+
+void test_realloc_counts_a_free_and_an_allocation()
+{
+    void *block = calloc(4, 8);
+    sink = block;
+    HeapGuard::Stats before = HeapGuard::stats();
+
+    block = realloc(block, 4096);
+    sink = block;
+    HeapGuard::Stats after = HeapGuard::stats();
+    TEST_ASSERT_EQUAL_UINT32(before.allocations + 1, after.allocations);
+    TEST_ASSERT_EQUAL_UINT32(before.frees + 1, after.frees);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(before.bytesInUse + 4096 - 32, after.bytesInUse);
+
+    free(block);
+}
+
+void test_new_and_delete_are_counted()
+{
+    HeapGuard::Stats before = HeapGuard::stats();
+
+    int *values = new int[16];
+    sink = values;
+    delete[] values;
+
+    HeapGuard::Stats after = HeapGuard::stats();
+    TEST_ASSERT_EQUAL_UINT32(before.allocations + 1, after.allocations);
+    TEST_ASSERT_EQUAL_UINT32(before.frees + 1, after.frees);
+    TEST_ASSERT_EQUAL_UINT32(before.bytesInUse, after.bytesInUse);
+}
+
+void test_allocation_after_lock_asserts()
+{
+    // The lock cannot be undone, so it is taken in a child process
+    fflush(stdout);
+    pid_t child = fork();
+    TEST_ASSERT_TRUE(child >= 0);
+    if (child == 0)
+    {
+        HeapGuard::lock();
+        sink = malloc(16);
+        _exit(0);
+    }
+
+    int status = 0;
+    TEST_ASSERT_EQUAL_INT(child, waitpid(child, &status, 0));
+    TEST_ASSERT_TRUE_MESSAGE(WIFSIGNALED(status), "allocation after lock() did not assert");
+    TEST_ASSERT_EQUAL_INT(SIGABRT, WTERMSIG(status));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_malloc_and_free_are_counted);
+    RUN_TEST(test_realloc_counts_a_free_and_an_allocation);
+    RUN_TEST(test_new_and_delete_are_counted);
+    RUN_TEST(test_allocation_after_lock_asserts);
+    return UNITY_END();
+}
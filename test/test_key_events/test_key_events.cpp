@@ -0,0 +1,164 @@
+#include <unity.h>
+#include "KeyEvents.h"
+
+namespace
+{
+    constexpr uint32_t LOCKOUT_US = 30000;
+
+    // Scripts start one lockout in, the queue starts with every key settled at time 0
+    constexpr uint32_t T0 = LOCKOUT_US;
+
+    struct Scan
+    {
+        uint32_t us;
+        uint8_t keys;
+    };
+
+    template <uint8_t CAPACITY, size_t N>
+    void replay(KeyEventQueue<CAPACITY> &queue, const Scan (&scans)[N])
+    {
+        for (const Scan &scan : scans)
+            queue.scan(scan.keys, T0 + scan.us);
+    }
+
+    void expectEvent(KeyEventQueue<16> &queue, uint8_t key, uint32_t us)
+    {
+        KeyEvent event;
+        TEST_ASSERT_TRUE(queue.pop(event));
+        TEST_ASSERT_EQUAL_UINT8(key, event.key);
+        TEST_ASSERT_EQUAL_UINT32(T0 + us, event.timeUs);
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Keys 5, 2, 7 down 150 us apart: queued in press order, not key order
+void test_staggered_burst_keeps_press_order()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {{0, 0x00}, {100, 0x20}, {250, 0x24}, {400, 0xA4}, {500, 0xA4}, {40000, 0x00}};
+    replay(queue, scans);
+
+    TEST_ASSERT_EQUAL_UINT8(3, queue.size());
+    expectEvent(queue, 5, 100);
+    expectEvent(queue, 2, 250);
+    expectEvent(queue, 7, 400);
+    TEST_ASSERT_EQUAL_UINT8(0, queue.size());
+}
+
+// Keys 1 and 6 seen by the same scan share its timestamp and queue by key index
+void test_same_scan_presses_share_a_timestamp()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {{0, 0x00}, {100, 0x42}, {40000, 0x00}, {80000, 0x08}};
+    replay(queue, scans);
+
+    expectEvent(queue, 1, 100);
+    expectEvent(queue, 6, 100);
+    expectEvent(queue, 3, 80000);
+}
+
+// Key 3 chattering every 200 us for 2 ms is one press, key 0 after it is the next
+void test_bounce_within_lockout_is_one_press()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {
+        {0, 0x00},    {100, 0x08},  {300, 0x00},  {500, 0x08},  {700, 0x00},  {900, 0x08},
+        {1100, 0x00}, {1300, 0x08}, {1500, 0x00}, {1700, 0x08}, {1900, 0x00}, {2100, 0x08},
+        {2300, 0x09},
+    };
+    replay(queue, scans);
+
+    TEST_ASSERT_EQUAL_UINT8(0x09, queue.held());
+    expectEvent(queue, 3, 100);
+    expectEvent(queue, 0, 2300);
+    TEST_ASSERT_EQUAL_UINT8(0, queue.size());
+}
+
+// A release that bounces back inside the lockout neither ends the press nor repeats it
+void test_release_bounce_does_not_repeat()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {{100, 0x04}, {50000, 0x00}, {50200, 0x04}, {50400, 0x00}, {60000, 0x00}};
+    replay(queue, scans);
+
+    expectEvent(queue, 2, 100);
+    TEST_ASSERT_EQUAL_UINT8(0, queue.size());
+    TEST_ASSERT_EQUAL_UINT8(0x00, queue.held());
+}
+
+void test_press_after_lockout_fires_again()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {{100, 0x01}, {40000, 0x00}, {80000, 0x01}};
+    replay(queue, scans);
+
+    expectEvent(queue, 0, 100);
+    expectEvent(queue, 0, 80000);
+}
+
+void test_clear_drops_events_but_held_keys_stay_down()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    queue.scan(0x10, T0 + 100);
+    queue.clear();
+    queue.scan(0x10, T0 + 50000);
+
+    TEST_ASSERT_EQUAL_UINT8(0, queue.size());
+    TEST_ASSERT_EQUAL_UINT8(0x10, queue.held());
+}
+
+void test_peek_reads_ahead_without_taking()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    const Scan scans[] = {{100, 0x01}, {300, 0x03}};
+    replay(queue, scans);
+
+    KeyEvent event;
+    TEST_ASSERT_TRUE(queue.peek(event, 1));
+    TEST_ASSERT_EQUAL_UINT8(1, event.key);
+    TEST_ASSERT_FALSE(queue.peek(event, 2));
+    TEST_ASSERT_EQUAL_UINT8(2, queue.size());
+}
+
+void test_full_queue_counts_dropped_presses()
+{
+    KeyEventQueue<2> queue(0);
+    queue.scan(0x01, 10);
+    queue.scan(0x03, 11);
+    queue.scan(0x07, 12);
+
+    TEST_ASSERT_EQUAL_UINT8(2, queue.size());
+    TEST_ASSERT_EQUAL_UINT16(1, queue.dropped());
+}
+
+// The lockout holds across the micros() wrap-around
+void test_lockout_across_micros_wrap()
+{
+    KeyEventQueue<16> queue(LOCKOUT_US);
+    queue.scan(0x01, 0xFFFFFF00u);
+    queue.scan(0x00, 0x00000100u); // 512 us later, still locked
+    queue.scan(0x01, 0x00000200u);
+
+    KeyEvent event;
+    TEST_ASSERT_TRUE(queue.pop(event));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF00u, event.timeUs);
+    TEST_ASSERT_EQUAL_UINT8(0, queue.size());
+    TEST_ASSERT_EQUAL_UINT8(0x01, queue.held());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_staggered_burst_keeps_press_order);
+    RUN_TEST(test_same_scan_presses_share_a_timestamp);
+    RUN_TEST(test_bounce_within_lockout_is_one_press);
+    RUN_TEST(test_release_bounce_does_not_repeat);
+    RUN_TEST(test_press_after_lockout_fires_again);
+    RUN_TEST(test_clear_drops_events_but_held_keys_stay_down);
+    RUN_TEST(test_peek_reads_ahead_without_taking);
+    RUN_TEST(test_full_queue_counts_dropped_presses);
+    RUN_TEST(test_lockout_across_micros_wrap);
+    return UNITY_END();
+}
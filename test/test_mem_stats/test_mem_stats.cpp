@@ -0,0 +1,92 @@
+#include <Arduino.h>
+#include <string.h>
+#include <unity.h>
+
+#include "MemStats.h"
+
+// Stack accounting on the simulated RAM of host builds
+
+namespace
+{
+    constexpr uint32_t RAM_WORDS = MemStats::SIMULATED_RAM_BYTES / 4;
+    constexpr uint32_t HEAP_END_BYTES = 4 * 1024;
+    constexpr uint32_t MARGIN_BYTES = MemStats::PAINT_MARGIN_WORDS * 4;
+
+    /**
+     * @brief Simulates the stack reaching down to the given number of bytes below the top.
+     */
+    void touchStack(uint32_t depthBytes)
+    {
+        MemStats::simulatedRam[RAM_WORDS - depthBytes / 4] = 0;
+    }
+}
+
+void setUp()
+{
+    memset(MemStats::simulatedRam, 0, sizeof(MemStats::simulatedRam));
+    MemStats::begin();
+}
+
+void tearDown() {}
+
+void test_sections_follow_the_simulated_map()
+{
+    MemStats::Report report = MemStats::report();
+
+    TEST_ASSERT_EQUAL_UINT32(1024, report.dataBytes);
+    TEST_ASSERT_EQUAL_UINT32(2048, report.bssBytes);
+    TEST_ASSERT_EQUAL_UINT32(1024, report.heapBytes);
+    TEST_ASSERT_EQUAL_UINT32(MemStats::SIMULATED_RAM_BYTES, report.totalBytes);
+}
+
+void test_begin_paints_up_to_the_margin()
+{
+    MemStats::Report report = MemStats::report();
+
+    TEST_ASSERT_EQUAL_UINT32(MARGIN_BYTES, report.stackPeakBytes);
+    TEST_ASSERT_EQUAL_UINT32(MemStats::SIMULATED_RAM_BYTES - HEAP_END_BYTES - MARGIN_BYTES, report.headroomBytes);
+    TEST_ASSERT_EQUAL_UINT32(MemStats::PAINT_PATTERN, MemStats::simulatedRam[HEAP_END_BYTES / 4]);
+    TEST_ASSERT_EQUAL_UINT32(0, MemStats::simulatedRam[HEAP_END_BYTES / 4 - 1]);
+}
+
+void test_deepest_write_sets_the_peak()
+{
+    touchStack(256);
+    touchStack(1024);
+    touchStack(512);
+
+    MemStats::Report report = MemStats::report();
+    TEST_ASSERT_EQUAL_UINT32(1024, report.stackPeakBytes);
+    TEST_ASSERT_EQUAL_UINT32(MemStats::SIMULATED_RAM_BYTES - HEAP_END_BYTES - 1024, report.headroomBytes);
+}
+
+void test_stack_reaching_the_heap_leaves_no_headroom()
+{
+    MemStats::simulatedRam[HEAP_END_BYTES / 4] = 0;
+
+    MemStats::Report report = MemStats::report();
+    TEST_ASSERT_EQUAL_UINT32(0, report.headroomBytes);
+    TEST_ASSERT_EQUAL_UINT32(MemStats::SIMULATED_RAM_BYTES - HEAP_END_BYTES, report.stackPeakBytes);
+}
+
+void test_untouched_bytes_stops_at_the_first_overwritten_word()
+{
+    uint32_t words[8];
+    MemStats::paint({words, words + 8});
+    TEST_ASSERT_EQUAL_UINT32(32, MemStats::untouchedBytes({words, words + 8}));
+
+    words[5] = 0;
+    words[7] = 0;
+    TEST_ASSERT_EQUAL_UINT32(20, MemStats::untouchedBytes({words, words + 8}));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sections_follow_the_simulated_map);
+    RUN_TEST(test_begin_paints_up_to_the_margin);
+    RUN_TEST(test_deepest_write_sets_the_peak);
+    RUN_TEST(test_stack_reaching_the_heap_leaves_no_headroom);
+    RUN_TEST(test_untouched_bytes_stops_at_the_first_overwritten_word);
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity.h>
+
+#include "PackedSequence.h"
+
+// Packed storage against a plain array, and the Memory Game repeat rule built on it
+
+namespace
+{
+    // MemoryGameConfig values; MemoryGame.h itself pulls in the hardware drivers
+    constexpr uint8_t NUM_LEDS = 8;
+    constexpr uint8_t MAX_REPEAT = 3;
+    using Sequence = PackedSequence<3, 32>;
+
+    uint32_t lcg = 1;
+
+    uint8_t nextRandom()
+    {
+        lcg = lcg * 1664525u + 1013904223u;
+        return lcg >> 24;
+    }
+
+    /**
+     * @brief Fills a sequence to capacity, checking every entry after each append.
+     *
+     * The write window of an entry covers its neighbours, so an append must
+     * leave all earlier entries intact.
+     */
+    template <uint8_t BITS, uint16_t CAPACITY>
+    void checkAgainstReference()
+    {
+        PackedSequence<BITS, CAPACITY> sequence;
+        uint8_t reference[CAPACITY];
+
+        for (uint8_t pass = 0; pass < 2; pass++)
+        {
+            sequence.clear();
+            for (uint16_t i = 0; i < CAPACITY; i++)
+            {
+                // High bits are dropped; the first pass leaves ones behind for the second to overwrite
+                uint8_t value = pass == 0 ? 0xFF : nextRandom();
+                reference[i] = value & PackedSequence<BITS, CAPACITY>::MAX_VALUE;
+                TEST_ASSERT_TRUE(sequence.append(value));
+                TEST_ASSERT_EQUAL_UINT16(i + 1, sequence.size());
+                TEST_ASSERT_EQUAL_UINT8(reference[i], sequence.back());
+
+                for (uint16_t j = 0; j <= i; j++)
+                    TEST_ASSERT_EQUAL_UINT8_MESSAGE(reference[j], sequence[j], "entry after an append");
+            }
+        }
+    }
+
+    template <uint8_t BITS, uint16_t CAPACITY>
+    void checkCapacity()
+    {
+        using Packed = PackedSequence<BITS, CAPACITY>;
+        static_assert(Packed::BYTES == (CAPACITY * BITS + 7) / 8 + 1, "one spare byte past the last entry");
+
+        Packed sequence;
+        for (uint16_t i = 0; i < CAPACITY; i++)
+        {
+            TEST_ASSERT_FALSE(sequence.full());
+            TEST_ASSERT_TRUE(sequence.append(Packed::MAX_VALUE));
+        }
+        TEST_ASSERT_TRUE(sequence.full());
+
+        // The last entry is read through the window that ends in the spare byte
+        TEST_ASSERT_EQUAL_UINT8(Packed::MAX_VALUE, sequence[CAPACITY - 1]);
+        TEST_ASSERT_FALSE(sequence.append(0));
+        TEST_ASSERT_EQUAL_UINT16(CAPACITY, sequence.size());
+        TEST_ASSERT_EQUAL_UINT8(Packed::MAX_VALUE, sequence.back());
+
+        sequence.clear();
+        TEST_ASSERT_FALSE(sequence.full());
+        TEST_ASSERT_EQUAL_UINT16(0, sequence.size());
+        TEST_ASSERT_TRUE(sequence.append(0));
+        TEST_ASSERT_EQUAL_UINT8(0, sequence[0]);
+    }
+
+    /**
+     * @brief MemoryGame::nextStep() with random() replaced by draw(range), which returns a value below range.
+     */
+    template <typename Draw>
+    uint8_t nextStep(const Sequence &sequence, Draw draw)
+    {
+        if (sequence.size() > 0 && sequence.trailingRun() >= MAX_REPEAT)
+        {
+            uint8_t value = draw(NUM_LEDS - 1);
+            return value >= sequence.back() ? value + 1 : value;
+        }
+        return draw(NUM_LEDS);
+    }
+
+    template <typename Draw>
+    void checkNoLongRuns(Draw draw)
+    {
+        Sequence sequence;
+        for (uint8_t round = 0; round < 50; round++)
+        {
+            sequence.clear();
+            while (!sequence.full())
+            {
+                uint8_t step = nextStep(sequence, [&](uint8_t range) { return draw(sequence, range); });
+                TEST_ASSERT_LESS_THAN(NUM_LEDS, step);
+                TEST_ASSERT_TRUE(sequence.append(step));
+            }
+
+            uint8_t run = 1;
+            for (uint16_t i = 1; i < sequence.size(); i++)
+            {
+                run = sequence[i] == sequence[i - 1] ? run + 1 : 1;
+                TEST_ASSERT_LESS_OR_EQUAL(MAX_REPEAT, run);
+            }
+        }
+    }
+}
+
+void setUp()
+{
+    lcg = 1;
+}
+
+void tearDown() {}
+
+// 3 bits straddle a byte boundary at entries 2 and 5 of every 8
+void test_entries_match_a_reference_array()
+{
+    checkAgainstReference<1, 37>();
+    checkAgainstReference<3, 32>();
+    checkAgainstReference<3, 33>();
+    checkAgainstReference<5, 19>();
+    checkAgainstReference<7, 17>();
+    checkAgainstReference<8, 16>();
+}
+
+void test_full_sequence_refuses_appends()
+{
+    checkCapacity<3, 32>();
+    checkCapacity<3, 1>();
+    checkCapacity<7, 9>();
+    checkCapacity<8, 4>();
+}
+
+void test_trailing_run_follows_appends()
+{
+    Sequence sequence;
+    TEST_ASSERT_EQUAL_UINT8(0, sequence.trailingRun());
+    TEST_ASSERT_EQUAL_UINT8(0, sequence.back());
+
+    const uint8_t values[] = {4, 4, 2, 2, 2, 7, 2, 2, 7, 7, 7, 7, 0};
+    const uint8_t runs[] = {1, 2, 1, 2, 3, 1, 1, 2, 1, 2, 3, 4, 1};
+    for (uint8_t i = 0; i < sizeof(values); i++)
+    {
+        TEST_ASSERT_TRUE(sequence.append(values[i]));
+        TEST_ASSERT_EQUAL_UINT8(runs[i], sequence.trailingRun());
+    }
+
+    // Values equal after masking count as the same
+    TEST_ASSERT_TRUE(sequence.append(8));
+    TEST_ASSERT_EQUAL_UINT8(2, sequence.trailingRun());
+
+    sequence.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, sequence.trailingRun());
+    TEST_ASSERT_TRUE(sequence.append(0));
+    TEST_ASSERT_EQUAL_UINT8(1, sequence.trailingRun());
+}
+
+void test_trailing_run_saturates()
+{
+    PackedSequence<1, 300> sequence;
+    for (uint16_t i = 0; i < 300; i++)
+        sequence.append(1);
+    TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, sequence.trailingRun());
+}
+
+// No draw, however unlucky, yields MAX_REPEAT + 1 equal steps in a row
+void test_next_step_never_repeats_four_times()
+{
+    checkNoLongRuns([](const Sequence &sequence, uint8_t range) {
+        return sequence.size() && sequence.back() < range ? sequence.back() : (uint8_t)0;
+    });
+    checkNoLongRuns([](const Sequence &, uint8_t) { return (uint8_t)0; });
+    checkNoLongRuns([](const Sequence &, uint8_t range) { return (uint8_t)(range - 1); });
+    checkNoLongRuns([](const Sequence &, uint8_t range) { return (uint8_t)(nextRandom() % range); });
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_entries_match_a_reference_array);
+    RUN_TEST(test_full_sequence_refuses_appends);
+    RUN_TEST(test_trailing_run_follows_appends);
+    RUN_TEST(test_trailing_run_saturates);
+    RUN_TEST(test_next_step_never_repeats_four_times);
+    return UNITY_END();
+}
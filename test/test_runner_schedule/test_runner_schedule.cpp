@@ -0,0 +1,93 @@
+#include <stdint.h>
+#include <unity.h>
+
+#include "RunnerSchedule.h"
+
+// Expansion of the Runner difficulty curve, checked against CURVE so a reshaped
+// curve keeps passing
+
+using namespace RunnerSchedule;
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_keyframes_apply_from_their_second()
+{
+    for (size_t key = 0; key < KEYFRAMES; key++)
+    {
+        const Entry &entry = at(CURVE[key].second);
+        TEST_ASSERT_EQUAL_UINT8(CURVE[key].level, entry.level);
+        TEST_ASSERT_EQUAL_UINT8(CURVE[key].spawnGapPercent, entry.spawnGapPercent);
+    }
+}
+
+void test_level_steps_and_gap_ramps_between_keyframes()
+{
+    for (size_t key = 0; key + 1 < KEYFRAMES; key++)
+    {
+        const Keyframe &from = CURVE[key];
+        const Keyframe &to = CURVE[key + 1];
+        uint8_t low = from.spawnGapPercent < to.spawnGapPercent ? from.spawnGapPercent : to.spawnGapPercent;
+        uint8_t high = from.spawnGapPercent < to.spawnGapPercent ? to.spawnGapPercent : from.spawnGapPercent;
+
+        uint8_t previous = from.spawnGapPercent;
+        for (uint32_t second = from.second; second < to.second && second < SECONDS; second++)
+        {
+            const Entry &entry = at(second);
+            TEST_ASSERT_EQUAL_UINT8(from.level, entry.level);
+            TEST_ASSERT_TRUE(entry.spawnGapPercent >= low && entry.spawnGapPercent <= high);
+            // Monotonic towards the next keyframe
+            if (to.spawnGapPercent < from.spawnGapPercent)
+                TEST_ASSERT_TRUE(entry.spawnGapPercent <= previous);
+            else
+                TEST_ASSERT_TRUE(entry.spawnGapPercent >= previous);
+            previous = entry.spawnGapPercent;
+        }
+    }
+}
+
+void test_last_keyframe_holds_to_the_end()
+{
+    const Keyframe &last = CURVE[KEYFRAMES - 1];
+    for (uint32_t second = last.second; second < SECONDS; second++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(last.level, at(second).level);
+        TEST_ASSERT_EQUAL_UINT8(last.spawnGapPercent, at(second).spawnGapPercent);
+    }
+}
+
+void test_seconds_past_the_table_use_the_last_entry()
+{
+    TEST_ASSERT_EQUAL_PTR(&TABLE.entries[SECONDS - 1], &at(SECONDS));
+    TEST_ASSERT_EQUAL_PTR(&TABLE.entries[SECONDS - 1], &at(UINT32_MAX));
+}
+
+void test_level_interval_speeds_up_and_clamps()
+{
+    TEST_ASSERT_EQUAL_UINT16(200, levelInterval(0, 200, 100, 900));
+    TEST_ASSERT_EQUAL_UINT16(180, levelInterval(1, 200, 100, 900));
+    TEST_ASSERT_EQUAL_UINT16(162, levelInterval(2, 200, 100, 900));
+    TEST_ASSERT_EQUAL_UINT16(100, levelInterval(MAX_LEVEL, 200, 100, 900));
+
+    uint16_t previous = levelInterval(0, 200, 50, 950);
+    for (uint8_t level = 1; level <= MAX_LEVEL; level++)
+    {
+        uint16_t interval = levelInterval(level, 200, 50, 950);
+        TEST_ASSERT_TRUE(interval < previous);
+        previous = interval;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(200, levelInterval(MAX_LEVEL, 200, 100, 1000));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_keyframes_apply_from_their_second);
+    RUN_TEST(test_level_steps_and_gap_ramps_between_keyframes);
+    RUN_TEST(test_last_keyframe_holds_to_the_end);
+    RUN_TEST(test_seconds_past_the_table_use_the_last_entry);
+    RUN_TEST(test_level_interval_speeds_up_and_clamps);
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+#include <Arduino.h>
+#include <IWatchdog.h>
+#include <string.h>
+#include <unity.h>
+
+#include "StallMonitor.h"
+
+// Loop iterations on the fake micros() of test/native/Arduino.h
+
+namespace
+{
+    constexpr uint32_t BUDGET_US = StallMonitor::DEFAULT_BUDGET_US;
+
+    /**
+     * @brief Collects everything printed to it.
+     */
+    class Capture : public Print
+    {
+    public:
+        using Print::write;
+        size_t write(uint8_t byte) override
+        {
+            if (length < sizeof(text) - 1)
+                text[length++] = byte;
+            text[length] = '\0';
+            return 1;
+        }
+
+        char text[2048] = {};
+        size_t length = 0;
+    };
+
+    /**
+     * @brief Runs one loop() iteration of the given length.
+     */
+    void tick(uint32_t durationUs, uint8_t game = 1, uint8_t state = 0)
+    {
+        StallMonitor::beginTick();
+        HostArduino::microsNow += durationUs;
+        StallMonitor::endTick(game, state);
+    }
+}
+
+void setUp()
+{
+    HostArduino::microsNow = 1000000;
+    StallMonitor::begin(BUDGET_US);
+    IWatchdog.reloads = 0;
+}
+
+void tearDown() {}
+
+void test_loop_within_budget_has_no_stalls()
+{
+    for (int i = 0; i < 1000; i++)
+        tick(1000 + i % 4000);
+    tick(BUDGET_US);
+
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, StallMonitor::stallCount(), "loop() stalled");
+    TEST_ASSERT_EQUAL_UINT32(1001, IWatchdog.reloads);
+}
+
+void test_over_budget_iteration_is_recorded()
+{
+    tick(1000);
+    uint32_t startMs = millis();
+    tick(BUDGET_US + 1000, 3, 7);
+
+    TEST_ASSERT_EQUAL_UINT32(1, StallMonitor::stallCount());
+
+    Capture out;
+    StallMonitor::dump(out);
+    char line[64];
+    snprintf(line, sizeof(line), "%u ms  %u us  game 3 state 7", (unsigned)startMs, (unsigned)(BUDGET_US + 1000));
+    TEST_ASSERT_NOT_NULL_MESSAGE(strstr(out.text, "stalls: 1 budget_us: 5000"), out.text);
+    TEST_ASSERT_NOT_NULL_MESSAGE(strstr(out.text, line), out.text);
+}
+
+void test_ring_keeps_the_latest_stalls()
+{
+    for (uint32_t i = 1; i <= StallMonitor::RING_SIZE + 4; i++)
+    {
+        tick(BUDGET_US + i);
+        tick(10);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(StallMonitor::RING_SIZE + 4, StallMonitor::stallCount());
+
+    Capture out;
+    StallMonitor::dump(out);
+    TEST_ASSERT_NULL_MESSAGE(strstr(out.text, "5004 us"), out.text);
+    const char *oldest = strstr(out.text, "5005 us");
+    const char *newest = strstr(out.text, "5020 us");
+    TEST_ASSERT_NOT_NULL_MESSAGE(oldest, out.text);
+    TEST_ASSERT_NOT_NULL_MESSAGE(newest, out.text);
+    TEST_ASSERT_TRUE(oldest < newest);
+}
+
+void test_realistic_loop_keeps_the_watchdog_fed()
+{
+    // 30 s of play: ~7 ms per iteration (LCD timer and TM1638 on 100 kHz I2C),
+    // a Runner render with glyph uploads every 10th and a Memory tone every 200th
+    constexpr unsigned long PLAY_US = 30000000;
+    unsigned long endUs = HostArduino::microsNow + PLAY_US;
+    unsigned long lastReloadUs = HostArduino::microsNow;
+    unsigned long longestGapUs = 0;
+    uint32_t iterations = 0;
+
+    while (HostArduino::microsNow < endUs)
+    {
+        uint32_t durationUs = 7000 + (iterations % 3) * 400;
+        if (iterations % 10 == 0)
+            durationUs = 60000;
+        if (iterations % 200 == 0)
+            durationUs = 400000;
+        tick(durationUs);
+        iterations++;
+
+        if (IWatchdog.lastReloadUs != lastReloadUs)
+        {
+            if (IWatchdog.lastReloadUs - lastReloadUs > longestGapUs)
+                longestGapUs = IWatchdog.lastReloadUs - lastReloadUs;
+            lastReloadUs = IWatchdog.lastReloadUs;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(iterations, StallMonitor::stallCount());
+    TEST_ASSERT_EQUAL_UINT32(iterations, IWatchdog.reloads);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(400000, longestGapUs);
+}
+
+void test_bogged_down_loop_starves_the_watchdog()
+{
+    tick(1000);
+    unsigned long progressUs = HostArduino::microsNow;
+
+    for (int i = 0; i < 100; i++)
+        tick(StallMonitor::PROGRESS_ITERATION_US + 1);
+
+    TEST_ASSERT_LESS_THAN_UINT32(StallMonitor::PROGRESS_WINDOW_MS * 1000UL + StallMonitor::PROGRESS_ITERATION_US,
+                                 IWatchdog.lastReloadUs - progressUs);
+    TEST_ASSERT_GREATER_THAN_UINT32(StallMonitor::WATCHDOG_TIMEOUT_US, HostArduino::microsNow - IWatchdog.lastReloadUs);
+
+    tick(1000);
+    TEST_ASSERT_EQUAL_UINT32(HostArduino::microsNow, IWatchdog.lastReloadUs);
+}
+
+void test_one_long_iteration_does_not_starve_the_watchdog()
+{
+    tick(1000);
+    tick(8000000); // Blocking melody
+    tick(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(HostArduino::microsNow, IWatchdog.lastReloadUs);
+}
+
+void test_isolated_stalls_keep_the_watchdog_fed()
+{
+    for (int i = 0; i < 100; i++)
+    {
+        tick(BUDGET_US * 3);
+        tick(100);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(100, StallMonitor::stallCount());
+    TEST_ASSERT_EQUAL_UINT32(200, IWatchdog.reloads);
+}
+
+void test_idle_always_feeds_the_watchdog()
+{
+    for (int i = 0; i < 30; i++)
+        tick(StallMonitor::PROGRESS_ITERATION_US + 1);
+    uint32_t reloads = IWatchdog.reloads;
+
+    StallMonitor::idle();
+    TEST_ASSERT_EQUAL_UINT32(reloads + 1, IWatchdog.reloads);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_loop_within_budget_has_no_stalls);
+    RUN_TEST(test_over_budget_iteration_is_recorded);
+    RUN_TEST(test_ring_keeps_the_latest_stalls);
+    RUN_TEST(test_realistic_loop_keeps_the_watchdog_fed);
+    RUN_TEST(test_bogged_down_loop_starves_the_watchdog);
+    RUN_TEST(test_one_long_iteration_does_not_starve_the_watchdog);
+    RUN_TEST(test_isolated_stalls_keep_the_watchdog_fed);
+    RUN_TEST(test_idle_always_feeds_the_watchdog);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+"""Flash/RAM budget of the asset tables (include/Assets.h).
+
+Runs as a PlatformIO pre-build script, or standalone:
+
+    python tools/asset_report.py
+
+Reports the size of the string, glyph and melody tables, how many duplicate
+string literals the shared IDs replace, and the RAM saved compared with
+keeping the bitmaps in mutable arrays. Warns about repeated texts in
+AssetStrings.def, unused IDs and string literals still passed to the display
+print paths. After a build it also checks in the ELF that no asset table
+ended up in RAM.
+"""
+
+import glob
+import os
+import re
+import subprocess
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO)
+except NameError:
+    env = None
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..") if env is None else env.subst("$PROJECT_DIR")
+STRINGS_DEF = os.path.join(ROOT, "include", "AssetStrings.def")
+ASSETS_CPP = os.path.join(ROOT, "src", "system", "Assets.cpp")
+POINTER_SIZE = 4
+NOTE_SIZE = 6
+MELODY_SIZE = 8
+ASSET_SYMBOLS = re.compile(r"\b(STRINGS|GLYPHS|MELODIES|\w+_NOTES)\b")
+
+
+def load_strings():
+    pattern = re.compile(r'^\s*ASSET_STRING\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+    with open(STRINGS_DEF, encoding="utf-8") as f:
+        return [m.groups() for m in map(pattern.match, f) if m]
+
+
+def source_files():
+    files = glob.glob(os.path.join(ROOT, "src", "**", "*.cpp"), recursive=True)
+    files += glob.glob(os.path.join(ROOT, "include", "*.h"))
+    return [f for f in files if os.path.basename(f) not in ("Assets.cpp", "Assets.h")]
+
+
+def report():
+    strings = load_strings()
+    sources = {path: open(path, encoding="utf-8").read() for path in source_files()}
+    warnings = []
+
+    # Strings
+    seen = {}
+    for string_id, text in strings:
+        if text in seen:
+            warnings.append('"%s" is defined twice (%s, %s)' % (text, seen[text], string_id))
+        seen[text] = string_id
+    string_bytes = sum(len(text) + 1 for _, text in strings) + POINTER_SIZE * len(strings)
+
+    merged = 0
+    merged_bytes = 0
+    for string_id, text in strings:
+        refs = sum(len(re.findall(r"StringId::%s\b" % string_id, src)) for src in sources.values())
+        if refs == 0:
+            warnings.append("StringId::%s is not used" % string_id)
+        elif refs > 1:
+            merged += refs - 1
+            merged_bytes += (refs - 1) * (len(text) + 1)
+
+    literal = re.compile(r'(?:lcd\.print|displayText|showTemporaryMessage)\(\s*"')
+    for path, src in sources.items():
+        for lineno, line in enumerate(src.splitlines(), 1):
+            if literal.search(line):
+                warnings.append("%s:%d: string literal on a display path, add it to AssetStrings.def" % (os.path.relpath(path, ROOT), lineno))
+
+    # Glyphs and melodies
+    with open(ASSETS_CPP, encoding="utf-8") as f:
+        assets = f.read()
+    glyph_block = assets[assets.index("GLYPHS[]"):assets.index("};", assets.index("GLYPHS[]"))]
+    glyphs = re.findall(r"\{(B[01]{5}(?:,\s*B[01]{5}){7})\}", glyph_block)
+    glyph_bytes = 8 * len(glyphs)
+    identical = len(glyphs) - len(set(g.replace(" ", "") for g in glyphs))
+    notes = len(re.findall(r"\{\d+,\s*\d+,\s*\d+\}", assets))
+    melodies = len(re.findall(r"melodyOf\([A-Z_]+_NOTES\b", assets))
+    melody_bytes = NOTE_SIZE * notes + MELODY_SIZE * melodies
+
+    print("Asset report")
+    print("  strings : %3d entries, %5d B flash" % (len(strings), string_bytes))
+    print("  glyphs  : %3d entries, %5d B flash (%d identical bitmaps)" % (len(glyphs), glyph_bytes, identical))
+    print("  melodies: %3d entries, %5d B flash (%d notes)" % (melodies, melody_bytes, notes))
+    print("  duplicate string literals merged: %d (%d B)" % (merged, merged_bytes))
+    print("  RAM saved vs mutable bitmap arrays: %d B" % glyph_bytes)
+    for warning in warnings:
+        print("  warning: " + warning)
+
+
+def check_elf(source, target, env):
+    """Warns if an asset table was placed in .data or .bss."""
+    elf = str(target[0])
+    nm_tool = (env.subst("$SIZETOOL") or "arm-none-eabi-size")[: -len("size")] + "nm"
+    try:
+        output = subprocess.check_output([nm_tool, "-C", elf]).decode()
+    except (OSError, subprocess.CalledProcessError):
+        return
+    in_ram = []
+    for line in output.splitlines():
+        parts = line.split(None, 2)
+        if len(parts) == 3 and parts[1] in "dDbB" and ASSET_SYMBOLS.search(parts[2]):
+            in_ram.append(parts[2])
+    if in_ram:
+        print("Asset report: warning, tables in RAM: " + ", ".join(sorted(in_ram)))
+    else:
+        print("Asset report: all asset tables are in flash")
+
+
+if env is not None:
+    report()
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", check_elf)
+elif __name__ == "__main__":
+    report()
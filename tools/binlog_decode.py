@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Decode the binary log stream written by BinLog (include/BinLog.h).
+
+Reads a raw capture file, or a serial port with --port (needs pyserial), and
+prints one line per record. Plain ASCII output from the firmware is passed
+through unchanged.
+
+    python tools/binlog_decode.py capture.bin
+    python tools/binlog_decode.py --port /dev/ttyACM0 --baud 115200
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SYNC = 0xA5
+FORMATS_DEF = os.path.join(os.path.dirname(__file__), "..", "include", "LogFormats.def")
+
+
+def load_formats(path):
+    """Returns the format strings from LogFormats.def, indexed by format ID."""
+    pattern = re.compile(r'^\s*LOG_FORMAT\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+    formats = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            match = pattern.match(line)
+            if match:
+                formats.append((match.group(1), match.group(2)))
+    return formats
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def render(text, args):
+    out = []
+    index = 0
+    for token in re.split(r"(\{leds\}|\{\})", text):
+        if token == "{}":
+            out.append(str(args[index]) if index < len(args) else "?")
+            index += 1
+        elif token == "{leds}":
+            count = args[index - 1] if index > 0 else 0
+            words = args[index:]
+            steps = []
+            for i in range(count):
+                word = words[i // 8] if i // 8 < len(words) else 0
+                steps.append("LED%d" % (((word >> ((i % 8) * 4)) & 0xF) + 1))
+            out.append(" -> ".join(steps))
+            index = len(args)
+        else:
+            out.append(token)
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, formats, out):
+        self.formats = formats
+        self.out = out
+        self.buffer = bytearray()
+        self.text = bytearray()
+
+    def feed(self, chunk):
+        self.buffer.extend(chunk)
+        while self.buffer:
+            if self.buffer[0] != SYNC:
+                self.flush_text(self.buffer[0])
+                del self.buffer[0]
+                continue
+            if len(self.buffer) < 3:
+                return
+            length = self.buffer[2]
+            total = 3 + length + 1
+            if len(self.buffer) < total:
+                return
+            record = bytes(self.buffer[:total])
+            if (sum(record[1:-1]) & 0xFF) != record[-1]:
+                # Not a valid record, treat the sync byte as noise
+                del self.buffer[0]
+                continue
+            del self.buffer[:total]
+            self.emit(record)
+
+    def flush_text(self, byte):
+        if byte == ord("\n"):
+            self.out.write(self.text.decode("ascii", "replace").rstrip("\r") + "\n")
+            self.text.clear()
+        else:
+            self.text.append(byte)
+
+    def emit(self, record):
+        format_id = record[1]
+        payload = record[3:-1]
+        timestamp, pos = read_varint(payload, 0)
+        args = []
+        while pos < len(payload):
+            value, pos = read_varint(payload, pos)
+            args.append(unzigzag(value))
+
+        if format_id < len(self.formats):
+            name, text = self.formats[format_id]
+            line = render(text, args)
+        else:
+            name, line = "Unknown%d" % format_id, " ".join(str(a) for a in args)
+        self.out.write("%10.3f %-20s %s\n" % (timestamp / 1000.0, name, line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", nargs="?", help="raw capture file")
+    parser.add_argument("--port", help="serial port to read from")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--formats", default=FORMATS_DEF, help="path to LogFormats.def")
+    args = parser.parse_args()
+
+    decoder = Decoder(load_formats(args.formats), sys.stdout)
+
+    if args.port:
+        import serial  # pyserial
+
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            while True:
+                decoder.feed(port.read(256))
+                sys.stdout.flush()
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            decoder.feed(f.read())
+    else:
+        decoder.feed(sys.stdin.buffer.read())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""Build, export and check asset packs (include/AssetPack.h).
+
+An asset pack overrides the built-in glyphs, melodies, UI strings and tuning
+values without rebuilding the firmware. Start from the built-in assets, edit
+the JSON and build the pack:
+
+    python tools/build_asset_pack.py export assets.json
+    python tools/build_asset_pack.py build assets.json -o assets.bin --pack-version 2
+    python tools/build_asset_pack.py check assets.bin
+
+Then write it to the reserved flash region, for example with
+    st-flash write assets.bin 0x08078000
+
+Entries missing from the JSON keep their built-in value. Tuning values are
+only stored if present in the JSON.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import zlib
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+ASSETS_H = os.path.join(ROOT, "include", "Assets.h")
+ASSETS_CPP = os.path.join(ROOT, "src", "system", "Assets.cpp")
+STRINGS_DEF = os.path.join(ROOT, "include", "AssetStrings.def")
+TUNING_DEF = os.path.join(ROOT, "include", "TuningKeys.def")
+FLASH_LAYOUT_H = os.path.join(ROOT, "include", "FlashLayout.h")
+
+MAGIC = 0x4B415041
+FORMAT_VERSION = 1
+HEADER = struct.Struct("<IIHHIII")
+SECTION = struct.Struct("<HHII")
+MELODY = struct.Struct("<HBBHH")
+NOTE = struct.Struct("<HHH")
+TUNING = struct.Struct("<HHi")
+SECTION_STRINGS, SECTION_GLYPHS, SECTION_MELODIES, SECTION_TUNING = 1, 2, 3, 4
+PACK_SIZE = 16 * 1024
+
+
+def read(path):
+    with open(path, encoding="utf-8") as f:
+        return f.read()
+
+
+def enum_names(source, name):
+    body = re.search(r"enum class %s\b[^{]*\{(.*?)\};" % name, source, re.S).group(1)
+    return [n for n in re.findall(r"^\s*(\w+)\s*,", body, re.M) if n != "Count"]
+
+
+def load_builtin():
+    """Returns the built-in assets from the firmware sources."""
+    header = read(ASSETS_H)
+    source = read(ASSETS_CPP)
+
+    strings = re.findall(r'^\s*ASSET_STRING\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', read(STRINGS_DEF), re.M)
+    strings = [(name, bytes(text, "utf-8").decode("unicode_escape")) for name, text in strings]
+
+    glyph_block = source[source.index("GLYPHS[]"):source.index("};", source.index("GLYPHS[]"))]
+    bitmaps = re.findall(r"\{(B[01]{5}(?:,\s*B[01]{5}){7})\}", glyph_block)
+    glyphs = [(name, [row.strip()[1:] for row in bitmap.split(",")])
+              for name, bitmap in zip(enum_names(header, "GlyphId"), bitmaps)]
+
+    note_tables = {}
+    for table, body in re.findall(r"const Note (\w+)\[\] = \{(.*?)\};", source, re.S):
+        note_tables[table] = [[int(v) for v in note] for note in re.findall(r"\{(\d+),\s*(\d+),\s*(\d+)\}", body)]
+    order = re.findall(r"melodyOf\((\w+),\s*(\d+)\)", source)
+    melodies = [(name, {"notes": note_tables[table], "pause": int(pause)})
+                for name, (table, pause) in zip(enum_names(header, "MelodyId"), order)]
+
+    tuning_keys = dict(re.findall(r"^\s*TUNING_KEY\(\s*(\w+)\s*,\s*(\d+)\s*\)", read(TUNING_DEF), re.M))
+    return {
+        "strings": strings,
+        "glyphs": glyphs,
+        "melodies": melodies,
+        "tuning_keys": {name: int(key) for name, key in tuning_keys.items()},
+    }
+
+
+def schema(builtin):
+    names = "".join(name + "\n" for name, _ in builtin["strings"])
+    return zlib.crc32(names.encode("ascii"))
+
+
+def pad4(data):
+    return data + b"\0" * (-len(data) % 4)
+
+
+def export(args):
+    builtin = load_builtin()
+    doc = {
+        "strings": dict(builtin["strings"]),
+        "glyphs": dict(builtin["glyphs"]),
+        "melodies": dict(builtin["melodies"]),
+        "tuning": {},
+        "_tuning_keys": sorted(builtin["tuning_keys"]),
+    }
+    with open(args.json, "w", encoding="utf-8") as f:
+        json.dump(doc, f, indent=2)
+        f.write("\n")
+    print("Wrote built-in assets to %s" % args.json)
+
+
+def build(args):
+    builtin = load_builtin()
+    with open(args.json, encoding="utf-8") as f:
+        doc = json.load(f)
+
+    def merged(kind):
+        overrides = doc.get(kind, {})
+        unknown = set(overrides) - set(name for name, _ in builtin[kind])
+        if unknown:
+            sys.exit("Unknown %s: %s" % (kind, ", ".join(sorted(unknown))))
+        return [overrides.get(name, value) for name, value in builtin[kind]]
+
+    # Strings: offset table, then the texts
+    texts = [text.encode("ascii") + b"\0" for text in merged("strings")]
+    offsets = []
+    position = 2 * len(texts)
+    for text in texts:
+        offsets.append(position)
+        position += len(text)
+    strings = struct.pack("<%dH" % len(texts), *offsets) + b"".join(texts)
+
+    # Glyphs: 8 rows of 5 pixels
+    glyphs = b""
+    for rows in merged("glyphs"):
+        if len(rows) != 8 or any(not re.fullmatch(r"[01]{5}", row) for row in rows):
+            sys.exit("Glyphs need 8 rows of 5 pixels, e.g. \"00110\"")
+        glyphs += bytes(int(row, 2) for row in rows)
+
+    # Melodies: entry table, then every note
+    entries = b""
+    notes = b""
+    first = 0
+    for melody in merged("melodies"):
+        entries += MELODY.pack(first, len(melody["notes"]), 0, melody["pause"], 0)
+        for frequency, duration, gap in melody["notes"]:
+            notes += NOTE.pack(frequency, duration, gap)
+        first += len(melody["notes"])
+    melodies = entries + notes
+
+    # Tuning: key/value pairs
+    tuning = b""
+    for name, value in doc.get("tuning", {}).items():
+        if name not in builtin["tuning_keys"]:
+            sys.exit("Unknown tuning key: %s" % name)
+        tuning += TUNING.pack(builtin["tuning_keys"][name], 0, value)
+
+    sections = [
+        (SECTION_STRINGS, len(texts), strings),
+        (SECTION_GLYPHS, len(builtin["glyphs"]), glyphs),
+        (SECTION_MELODIES, len(builtin["melodies"]), melodies),
+        (SECTION_TUNING, len(tuning) // TUNING.size, tuning),
+    ]
+
+    index = b""
+    body = b""
+    offset = HEADER.size + SECTION.size * len(sections)
+    for kind, count, data in sections:
+        index += SECTION.pack(kind, count, offset + len(body), len(data))
+        body += pad4(data)
+    total = offset + len(body)
+    if total > PACK_SIZE:
+        sys.exit("Pack is %d bytes, the flash region holds %d" % (total, PACK_SIZE))
+
+    rest = HEADER.pack(MAGIC, 0, FORMAT_VERSION, len(sections), args.pack_version, total, schema(builtin))[8:]
+    crc = zlib.crc32(rest + index + body)
+    pack = struct.pack("<II", MAGIC, crc) + rest + index + body
+
+    with open(args.output, "wb") as f:
+        f.write(pack)
+    print("Wrote %s: version %d, %d bytes, CRC %08X" % (args.output, args.pack_version, total, crc))
+    print("Flash it with: st-flash write %s 0x%08X" % (args.output, pack_address()))
+
+
+def check(args):
+    with open(args.pack, "rb") as f:
+        pack = f.read()
+    magic, crc, fmt, count, version, total, pack_schema = HEADER.unpack_from(pack)
+    problems = []
+    if magic != MAGIC or fmt != FORMAT_VERSION:
+        problems.append("bad header")
+    elif total > len(pack) or zlib.crc32(pack[8:total]) != crc:
+        problems.append("CRC mismatch")
+    if pack_schema != schema(load_builtin()):
+        problems.append("built for a different string table")
+    if problems:
+        sys.exit("%s: %s" % (args.pack, ", ".join(problems)))
+    print("%s: version %d, %d bytes, %d sections, OK" % (args.pack, version, total, count))
+    for i in range(count):
+        kind, entries, offset, size = SECTION.unpack_from(pack, HEADER.size + i * SECTION.size)
+        print("  section %d: %d entries, %d bytes at +%d" % (kind, entries, size, offset))
+
+
+def pack_address():
+    layout = read(FLASH_LAYOUT_H)
+    base = int(re.search(r"BASE_ADDR = (0x[0-9A-Fa-f]+)", layout).group(1), 16)
+    app = int(re.search(r"APP_SIZE = (\d+)UL \* 1024", layout).group(1)) * 1024
+    return base + app
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    p = commands.add_parser("export", help="write the built-in assets as JSON")
+    p.add_argument("json")
+    p.set_defaults(func=export)
+
+    p = commands.add_parser("build", help="build a pack from JSON")
+    p.add_argument("json")
+    p.add_argument("-o", "--output", default="assets.bin")
+    p.add_argument("--pack-version", type=int, default=1)
+    p.set_defaults(func=build)
+
+    p = commands.add_parser("check", help="validate a pack")
+    p.add_argument("pack")
+    p.set_defaults(func=check)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
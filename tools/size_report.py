@@ -0,0 +1,56 @@
+"""PlatformIO post-build script that reports flash and RAM usage per environment.
+
+The sizes of every environment built in this project are kept in
+.pio/build/size_history.json, so building two environments back to back shows
+what one costs relative to the other:
+
+    pio run -e release -e debug
+"""
+
+import json
+import os
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+FLASH_SECTIONS = (".isr_vector", ".text", ".rodata", ".ARM.extab", ".ARM", ".preinit_array", ".init_array", ".fini_array", ".data")
+RAM_SECTIONS = (".data", ".bss")
+
+
+def read_sections(size_tool, elf):
+    output = subprocess.check_output([size_tool, "-A", "-d", elf]).decode()
+    sections = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = int(parts[1])
+    return sections
+
+
+def report_size(source, target, env):
+    elf = str(target[0])
+    size_tool = env.subst("$SIZETOOL") or "arm-none-eabi-size"
+    sections = read_sections(size_tool, elf)
+    flash = sum(sections.get(name, 0) for name in FLASH_SECTIONS)
+    ram = sum(sections.get(name, 0) for name in RAM_SECTIONS)
+
+    name = env.subst("$PIOENV")
+    history_path = os.path.join(env.subst("$PROJECT_BUILD_DIR"), "size_history.json")
+    try:
+        with open(history_path, encoding="utf-8") as f:
+            history = json.load(f)
+    except (OSError, ValueError):
+        history = {}
+
+    print("Size [%s]: flash %d B, RAM %d B" % (name, flash, ram))
+    for other, sizes in sorted(history.items()):
+        if other == name:
+            continue
+        print("  vs %-12s flash %+d B, RAM %+d B" % (other, flash - sizes["flash"], ram - sizes["ram"]))
+
+    history[name] = {"flash": flash, "ram": ram}
+    with open(history_path, "w", encoding="utf-8") as f:
+        json.dump(history, f, indent=2, sort_keys=True)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", report_size)  # noqa: F821
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Turn a telemetry export (include/Telemetry.h) into CSV.
+
+Send "telemetry dump" on the console and capture the serial output, or let
+this script do both with --port (needs pyserial):
+
+    python tools/telemetry_decode.py capture.bin -o sessions.csv
+    python tools/telemetry_decode.py --port /dev/ttyACM0 -o sessions.csv
+
+Anything around the export frame (console text, binary log records) is
+ignored.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import time
+import zlib
+
+MAGIC = b"TLM"
+VERSION = 1
+HEADER = struct.Struct("<3sBHH")
+# Telemetry::SessionRecord, keep in sync with include/Telemetry.h
+RECORD = struct.Struct("<HBB4HHBBB8B3B")
+OUTCOMES = {0: "running", 1: "win", 2: "timeout"}
+FLAG_RESUMED = 0x01
+CHALLENGES = ("runner", "memory", "escape", "archery")
+
+COLUMNS = (["session", "outcome", "resumed"]
+           + ["%s_s" % name for name in CHALLENGES] + ["total_s"]
+           + ["runner_deaths", "runner_best_score"]
+           + ["memory_errors_l%d" % level for level in range(1, 9)]
+           + ["escape_gate_failures", "escape_restarts"]
+           + ["archery_arrows_r%d" % rnd for rnd in range(1, 4)])
+
+
+def find_frame(data):
+    """Returns the records of the last valid export frame in data, or None."""
+    start = data.rfind(MAGIC + bytes([VERSION]))
+    while start >= 0:
+        if start + HEADER.size <= len(data):
+            _, _, count, size = HEADER.unpack_from(data, start)
+            end = start + HEADER.size + count * size
+            if size == RECORD.size and end + 4 <= len(data):
+                (crc,) = struct.unpack_from("<I", data, end)
+                if zlib.crc32(data[start:end]) == crc:
+                    body = data[start + HEADER.size:end]
+                    return [RECORD.unpack_from(body, i * size) for i in range(count)]
+        start = data.rfind(MAGIC + bytes([VERSION]), 0, start)
+    return None
+
+
+def row(fields):
+    session, outcome, flags = fields[0:3]
+    seconds = list(fields[3:7])
+    best_score = fields[7]
+    deaths, gate_failures, restarts = fields[8:11]
+    memory_errors = list(fields[11:19])
+    arrows = list(fields[19:22])
+    return ([session, OUTCOMES.get(outcome, outcome), int(bool(flags & FLAG_RESUMED))]
+            + seconds + [sum(seconds)]
+            + [deaths, best_score]
+            + memory_errors
+            + [gate_failures, restarts]
+            + arrows)
+
+
+def capture_port(port, baud):
+    import serial  # pyserial
+
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.5) as link:
+        link.reset_input_buffer()
+        link.write(b"telemetry dump\n")
+        deadline = time.time() + 5
+        while time.time() < deadline:
+            data.extend(link.read(4096))
+            if find_frame(bytes(data)) is not None:
+                break
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", nargs="?", help="raw capture file")
+    parser.add_argument("--port", help="serial port to request the export from")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("-o", "--output", help="CSV file, stdout by default")
+    args = parser.parse_args()
+
+    if args.port:
+        data = capture_port(args.port, args.baud)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    records = find_frame(data)
+    if records is None:
+        sys.exit("No valid telemetry export found")
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(COLUMNS)
+    for fields in records:
+        writer.writerow(row(fields))
+    if args.output:
+        out.close()
+        print("Wrote %d sessions to %s" % (len(records), args.output))
+
+
+if __name__ == "__main__":
+    main()